@@ -20,9 +20,10 @@ void irqDispatcher(uint64_t irq, uint64_t rsp) {
 
 static void int20(uint64_t rsp) {
   timeHandler();
-  lottery(rsp);
+  schedule(rsp);
 }
 
 static void int21() {
   keyboardHandler();
+  preemptOnIrq();
 }
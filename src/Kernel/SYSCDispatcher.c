@@ -1,15 +1,19 @@
 #include <stdint.h>
 #include "include/SYSCDispatcher.h"
+#include "include/futex.h"
 #include "include/keyboardDriver.h"
 #include "include/memoryManager.h"
 #include "include/mutex.h"
 #include "include/nice.h"
 #include "include/process.h"
+#include "include/registry.h"
 #include "include/scheduler.h"
 #include "include/semaphore.h"
 #include "include/timeDriver.h"
+#include "include/tty.h"
 #include "include/videoDriver.h"
 #include "include/pipe.h"
+#include "include/slab.h"
 
 #include "include/lib.h"
 
@@ -48,7 +52,31 @@ typedef enum {
   RUNPROCESS,
   SETPROCESS,
   FDCLOSE,
-  NICE
+  NICE,
+  SLABINFO,
+  SCHEDBENCH,
+  SETTIMER,
+  GETTIMER,
+  SETQUANTUM,
+  GETQUANTUM,
+  GETTICKS,
+  VMSPLICE,
+  SPLICE,
+  MUTEXLOCKHANDLE,
+  MUTEXUNLOCKHANDLE,
+  SEMWAITHANDLE,
+  SEMPOSTHANDLE,
+  FUTEXWAIT,
+  FUTEXWAKE,
+  SEMWAITN,
+  SEMPOSTN,
+  CONDWAIT,
+  CONDSIGNAL,
+  CONDBROADCAST,
+  TTYMODE,
+  TTYLATENCY,
+  HANDOFF,
+  YIELD
 } Syscall;
 
 typedef enum { HOUR, MINUTE, SECOND } Time;
@@ -56,11 +84,8 @@ typedef enum { HOUR, MINUTE, SECOND } Time;
 void beepon();
 void beepoff();
 
-void _cli();
-void _sti();
-
-static void _read(int fd, char* buffer, int size);
-static void _write(int fd, char* buffer, int size);
+static int _read(int fd, char* buffer, int size);
+static int _write(int fd, char* buffer, int size);
 static void _getTime(unsigned int *dest, uint64_t time);
 static void _wait(int *sec);
 static void _getScreenSize(int *x, int *y);
@@ -78,28 +103,52 @@ static unsigned long int _createProc(char *name, int (*entry)(int, char **),
                                      int argc, char **argv, int priority);
 static void _kill(unsigned long int pid);
 static void _ps(tProcessData ***psVec, int *size);
-static void _waitpid(unsigned long int pid);
+static long int _waitpid(long int pid, int *status, int options);
 
 static int _mutexOpen(char id[MAX_MUTEX_ID]);
 static int _mutexClose(char id[MAX_MUTEX_ID]);
 static int _mutexLock(char id[MAX_MUTEX_ID]);
 static int _mutexUnlock(char id[MAX_MUTEX_ID]);
+static int _mutexLockHandle(int handle);
+static int _mutexUnlockHandle(int handle);
 
 static int _semOpen(char id[MAX_SEM_ID], int start);
 static int _semClose(char id[MAX_SEM_ID]);
 static int _semWait(char id[MAX_SEM_ID]);
 static int _semPost(char id[MAX_SEM_ID]);
+static int _semWaitHandle(int handle);
+static int _semPostHandle(int handle);
+static int _semWaitN(int handle, int count);
+static int _semPostN(int handle, int count);
+static int _condWait(int cond, int mutex);
+static int _condSignal(int cond);
+static int _condBroadcast(int cond);
+static int _futexWait(int *address, int expected);
+static int _futexWake(int *address, int count);
+static int _ttyMode(int mode);
+static void _ttyLatency(tTtyLatency *result);
+static int _handoff(int enabled);
+static void _yield();
 
 static void _eraseScreen(int y1, int y2);
 static void _resetCursor();
 
-static void _pipe(int fd[2]);
+static int _pipe(int fd[2]);
 static void _dup(int pid, int fd, int pos);
 static void _runProcess(int pid);
 static unsigned long int _setProcess(char *name, int (*entry)(int, char **),
                                      int argc, char **argv, int priority);
 static void _closeFD(int fd);
 static void _nice(unsigned long int pid, int priority);
+static void _slabInfo();
+static void _schedBench(int processes, int draws, tSchedBench *result);
+static void _setTimer(unsigned int hz);
+static void _getTimer(unsigned int *hz);
+static void _setQuantum(int priority, int ticks);
+static void _getQuantum(int priority, int *ticks);
+static void _getTicks(int *ticks);
+static int _vmsplice(int fd, char *page, int bytes);
+static int _splice(int fd, char **page);
 
 
 typedef uint64_t (*SystemCall)();
@@ -123,20 +172,34 @@ SystemCall syscall_array[] = {
     (SystemCall)_resetCursor,   (SystemCall)_pipe,
     (SystemCall)_dup,           (SystemCall)_runProcess,
     (SystemCall)_setProcess,    (SystemCall)_closeFD,
-    (SystemCall)_nice};
-
-void syscallDispatcher(uint64_t syscall, uint64_t p1, uint64_t p2, uint64_t p3,
-                       uint64_t p4, uint64_t p5) {
-  syscall_array[syscall](p1, p2, p3, p4, p5);
+    (SystemCall)_nice,          (SystemCall)_slabInfo,
+    (SystemCall)_schedBench,    (SystemCall)_setTimer,
+    (SystemCall)_getTimer,      (SystemCall)_setQuantum,
+    (SystemCall)_getQuantum,    (SystemCall)_getTicks,
+    (SystemCall)_vmsplice,      (SystemCall)_splice,
+    (SystemCall)_mutexLockHandle, (SystemCall)_mutexUnlockHandle,
+    (SystemCall)_semWaitHandle, (SystemCall)_semPostHandle,
+    (SystemCall)_futexWait,     (SystemCall)_futexWake,
+    (SystemCall)_semWaitN,      (SystemCall)_semPostN,
+    (SystemCall)_condWait,      (SystemCall)_condSignal,
+    (SystemCall)_condBroadcast, (SystemCall)_ttyMode,
+    (SystemCall)_ttyLatency,    (SystemCall)_handoff,
+    (SystemCall)_yield};
+
+uint64_t syscallDispatcher(uint64_t syscall, uint64_t p1, uint64_t p2,
+                           uint64_t p3, uint64_t p4, uint64_t p5) {
+  uint64_t result = syscall_array[syscall](p1, p2, p3, p4, p5);
+  preemptOnSyscall();
+  return result;
 }
 
 
-static void _read(int fd, char* buff, int size) {
-  read(fd, buff, size);
+static int _read(int fd, char* buff, int size) {
+  return read(fd, buff, size);
 }
 
-static void _write(int fd, char* buff, int size) {
-  write(fd, buff, size);
+static int _write(int fd, char* buff, int size) {
+  return write(fd, buff, size);
 }
 
 static void _wait(int *sec) { wait(*sec); }
@@ -173,27 +236,22 @@ static void _getCursor(int *x, int *y) { getCursor(x, y); }
 
 static void _setCursor(int *x, int *y) { setCursor(*x, *y); }
 
-static void _malloc(void **dest, size_t size) { 
-  _cli();
-  *dest = malloc(size); 
-  _sti();
+static void _malloc(void **dest, size_t size) {
+  *dest = malloc(size);
 }
 
 static void _realloc(void *src, size_t size, void **dest) {
-  _cli();
   *dest = realloc(src, size);
-  _sti();
 }
 
-static void _free(void *src) { 
-  _cli();
+static void _free(void *src) {
   free(src);
-  _sti(); 
 }
 
 static unsigned long int _createProc(char *name, int (*entry)(int, char **),
                                      int argc, char **argv, int priority) {
   tProcess *newP = newProcess(name, entry, argc, argv, priority);
+  if (newP == NULL) return -1;
   initStack(newP);
   addProcess(newP);
   return newP->pid;
@@ -201,159 +259,159 @@ static unsigned long int _createProc(char *name, int (*entry)(int, char **),
 
 static void _printNode(void *src) { printNode(src); }
 
-static void _kill(unsigned long int pid) {
-  killProc(pid);
-  freeProcess(getProcess(pid));
-}
+static void _kill(unsigned long int pid) { killProc(pid); }
 
 static void _ps(tProcessData ***psVec, int *size) {
-  _cli();
   ps(psVec, size);
-  _sti();
 }
 
-// agregar mutex
-static void _waitpid(unsigned long int pid) {
-  _sti();
-  while (getProcess(pid) != NULL) { }
+static long int _waitpid(long int pid, int *status, int options) {
+  return waitChild(pid, status, options);
 }
 
-static int mutexCmp(void *a, void *b) {
-  char *left = (*((MutexData **)a))->id;
-  char *right = (*((MutexData **)b))->id;
-
-  return strcmp(left, right);
-}
+// Opens the mutex (creating it the first time) and returns its handle
 static int _mutexOpen(char id[MAX_MUTEX_ID]) {
-  if (mutexQueue == NULL) {
-    mutexQueue = queueCreate(sizeof(MutexData *));
-  }
-  MutexData *data;
-  queueResetIter(mutexQueue);
-  while (queueGetNext(mutexQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      return 1;  // mutex already open
-    }
-  }
-  data = malloc(sizeof(MutexData));
-  memcpy(data->id, id, strlen(id) + 1);
-  data->mutex = mutexCreate();
-  queueOffer(mutexQueue, &data);
-  return 0;
+  int handle = registryFind(id, OBJ_MUTEX);
+  if (handle != NO_HANDLE) return handle;
+  mutex_t mutex = mutexCreate();
+  handle = registryAdd(id, OBJ_MUTEX, mutex);
+  if (handle == NO_HANDLE) mutexDelete(mutex);
+  return handle;
 }
 
 static int _mutexClose(char id[MAX_MUTEX_ID]) {
-  if (mutexQueue == NULL) return 1;
-  MutexData *data;
-  queueResetIter(mutexQueue);
-  while (queueGetNext(mutexQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      mutexDelete(data->mutex);
-      queueRemove(mutexQueue, &mutexCmp, &data);
-      free(data);
-      return 1;
-    }
-  }
-  return 2;
+  mutex_t mutex = registryRemove(registryFind(id, OBJ_MUTEX), OBJ_MUTEX);
+  if (mutex == NULL) return 2;
+  mutexDelete(mutex);
+  return 1;
 }
+
 static int _mutexLock(char id[MAX_MUTEX_ID]) {
-  if (mutexQueue == NULL) return 1;
-  MutexData *data;
-  queueResetIter(mutexQueue);
-  while (queueGetNext(mutexQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      mutexLock(data->mutex);
-      return 0;
-    }
-  }
-  return 2;
+  return _mutexLockHandle(registryFind(id, OBJ_MUTEX));
 }
+
 static int _mutexUnlock(char id[MAX_MUTEX_ID]) {
-  if (mutexQueue == NULL) return 1;
-  MutexData *data;
-  queueResetIter(mutexQueue);
-  while (queueGetNext(mutexQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      mutexUnlock(data->mutex);
-      return 0;
-    }
-  }
-  return 2;
+  return _mutexUnlockHandle(registryFind(id, OBJ_MUTEX));
 }
 
-static int semCmp(void *a, void *b) {
-  char *left = (*((SemData **)a))->id;
-  char *right = (*((SemData **)b))->id;
+static int _mutexLockHandle(int handle) {
+  mutex_t mutex = registryGet(handle, OBJ_MUTEX);
+  if (mutex == NULL) return 2;
+  mutexLock(mutex);
+  return 0;
+}
 
-  return strcmp(left, right);
+// Only the owner may unlock the mutex
+static int _mutexUnlockHandle(int handle) {
+  mutex_t mutex = registryGet(handle, OBJ_MUTEX);
+  if (mutex == NULL || mutex->owner != getCurrentProcess()) return 2;
+  mutexUnlock(mutex);
+  return 0;
 }
 
+// Opens the semaphore (creating it with start the first time) and returns
+// its handle
 static int _semOpen(char id[MAX_SEM_ID], int start) {
-  if (semQueue == NULL) {
-    semQueue = queueCreate(sizeof(SemData *));
-  }
-  SemData *data;
-  queueResetIter(semQueue);
-  while (queueGetNext(semQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      return 1;  // sem already open
-    }
-  }
-  data = malloc(sizeof(SemData));
-  memcpy(data->id, id, strlen(id) + 1);
-  data->sem = semCreate(start);
-  queueOffer(semQueue, &data);
-  return 0;
+  int handle = registryFind(id, OBJ_SEM);
+  if (handle != NO_HANDLE) return handle;
+  sem_t sem = semCreate(start);
+  handle = registryAdd(id, OBJ_SEM, sem);
+  if (handle == NO_HANDLE) semDelete(sem);
+  return handle;
 }
 
 static int _semClose(char id[MAX_SEM_ID]) {
-  if (semQueue == NULL) return 1;
-  SemData *data;
-  queueResetIter(semQueue);
-  while (queueGetNext(semQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      semDelete(data->sem);
-      queueRemove(semQueue, &semCmp, &data);
-      free(data);
-      return 1;
-    }
-  }
-  return 2;
+  sem_t sem = registryRemove(registryFind(id, OBJ_SEM), OBJ_SEM);
+  if (sem == NULL) return 2;
+  semDelete(sem);
+  return 1;
 }
+
 static int _semWait(char id[MAX_SEM_ID]) {
-  if (semQueue == NULL) return 1;
-  SemData *data;
-  queueResetIter(semQueue);
-  while (queueGetNext(semQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      semWait(data->sem);
-      return 0;
-    }
-  }
-  return 2;
+  return _semWaitHandle(registryFind(id, OBJ_SEM));
 }
+
 static int _semPost(char id[MAX_SEM_ID]) {
-  if (semQueue == NULL) return 1;
-  SemData *data;
-  queueResetIter(semQueue);
-  while (queueGetNext(semQueue, &data) == 0) {
-    if (strcmp(id, data->id) == 0) {
-      semPost(data->sem);
-      return 0;
-    }
+  return _semPostHandle(registryFind(id, OBJ_SEM));
+}
+
+static int _semWaitHandle(int handle) {
+  sem_t sem = registryGet(handle, OBJ_SEM);
+  if (sem == NULL) return 2;
+  semWait(sem);
+  return 0;
+}
+
+static int _semPostHandle(int handle) {
+  sem_t sem = registryGet(handle, OBJ_SEM);
+  if (sem == NULL) return 2;
+  semPost(sem);
+  return 0;
+}
+
+static int _semWaitN(int handle, int count) {
+  sem_t sem = registryGet(handle, OBJ_SEM);
+  if (sem == NULL) return 2;
+  semWaitN(sem, count);
+  return 0;
+}
+
+static int _semPostN(int handle, int count) {
+  sem_t sem = registryGet(handle, OBJ_SEM);
+  if (sem == NULL) return 2;
+  semPostN(sem, count);
+  return 0;
+}
+
+// Condition variables are semaphores opened with semOpen, the mutex must be
+// held by the caller
+static int _condWait(int cond, int mutex) {
+  sem_t sem = registryGet(cond, OBJ_SEM);
+  mutex_t lock = registryGet(mutex, OBJ_MUTEX);
+  if (sem == NULL || lock == NULL || lock->owner != getCurrentProcess()) {
+    return 2;
   }
-  return 2;
+  condWait(sem, lock);
+  return 0;
 }
 
+static int _condSignal(int cond) {
+  sem_t sem = registryGet(cond, OBJ_SEM);
+  if (sem == NULL) return 2;
+  condSignal(sem);
+  return 0;
+}
+
+static int _condBroadcast(int cond) {
+  sem_t sem = registryGet(cond, OBJ_SEM);
+  if (sem == NULL) return 2;
+  condBroadcast(sem);
+  return 0;
+}
+
+static int _futexWait(int *address, int expected) {
+  return futexWait(address, expected);
+}
+
+static int _futexWake(int *address, int count) {
+  return futexWake(address, count);
+}
+
+static int _ttyMode(int mode) { return ttySetMode(mode); }
+
+static void _ttyLatency(tTtyLatency *result) { ttyLatency(result); }
+
+static int _handoff(int enabled) { return setHandoff(enabled); }
+
+static void _yield() { yield(); }
+
 static void _eraseScreen(int y1, int y2) { eraseScreen(y1, y2); }
 
 static void _resetCursor() {
   resetCursor();
 }
 
-static void _pipe(int fd[2]) {
-  pipe(fd);
-}
+static int _pipe(int fd[2]) { return pipe(fd); }
 
 static void _dup(int pid, int fd, int pos) {
   tProcess* process = getProcess(pid);
@@ -371,6 +429,7 @@ static void _runProcess(int pid) {
 static unsigned long int _setProcess(char *name, int (*entry)(int, char **),
                                      int argc, char **argv, int priority) {
   tProcess *newP = newProcess(name, entry, argc, argv, priority);
+  if (newP == NULL) return -1;
   return newP->pid;
 }
 
@@ -385,3 +444,32 @@ static void _nice(unsigned long int pid, int priority) {
     nice(pid, priority);
   }
 }
+
+static void _slabInfo() { printSlabs(); }
+
+// Runs with interrupts disabled so no context switch skews the measures
+static void _schedBench(int processes, int draws, tSchedBench *result) {
+  schedBenchmark(processes, draws, result);
+}
+
+static void _setTimer(unsigned int hz) { setTimerFrequency(hz); }
+
+static void _getTimer(unsigned int *hz) { *hz = getTimerFrequency(); }
+
+static void _setQuantum(int priority, int ticks) {
+  if (priority == HIGHP || priority == MIDP || priority == LOWP) {
+    setQuantum(priority, ticks);
+  }
+}
+
+static void _getQuantum(int priority, int *ticks) {
+  *ticks = getQuantum(priority);
+}
+
+static void _getTicks(int *ticks) { *ticks = ticksElapsed(); }
+
+static int _vmsplice(int fd, char *page, int bytes) {
+  return vmsplice(fd, page, bytes);
+}
+
+static int _splice(int fd, char **page) { return splice(fd, page); }
@@ -1,6 +1,7 @@
 GLOBAL cpuVendor
 GLOBAL printTimeASM
 GLOBAL _go_to
+GLOBAL _rdtsc
 
 section .text
 	
@@ -33,4 +34,11 @@ _go_to:
 	mov rsp, rdi
 	mov [rsp], rbp
 	mov rbp, rsp
-	ret
\ No newline at end of file
+	ret
+
+; Returns the time stamp counter (cycles since reset)
+_rdtsc:
+	rdtsc
+	shl rdx, 32
+	or rax, rdx
+	ret
@@ -1,9 +1,36 @@
 GLOBAL _runProcess
 GLOBAL _initStack
-GLOBAL _interrupt
+GLOBAL _switchTo
 
 section .text
 
+; void _switchTo(uint64_t* saveRsp, uint64_t rsp): voluntary switch. Only
+; the registers a C call must preserve are saved, the rest are already dead
+; for the caller. The process switched to resumes returning from its own
+; _switchTo call (or in _firstRun if it never ran)
+_switchTo:
+	push rbp
+	push rbx
+	push r12
+	push r13
+	push r14
+	push r15
+	mov [rdi], rsp
+
+	mov rsp, rsi
+	pop r15
+	pop r14
+	pop r13
+	pop r12
+	pop rbx
+	pop rbp
+	ret
+
+; A new process starts by unwinding the interrupt frame _initStack built
+_firstRun:
+	mov rdi, rsp
+	jmp _runProcess
+
 _runProcess:
 	
 	mov rsp, rdi
@@ -36,12 +63,12 @@ _initStack:
 	mov rbp, rsp
 
 	mov rsp, rdi ; stack pointer of new process
-	mov rbx, rsp ; base stack pointer for new process
+	mov rax, rsp ; base stack pointer for new process (rbx is the caller's)
 
 	; simulation for interruped stack
 	push 0x0  ; Align
 	push 0x0	; SS
-	push rbx  ; RSP
+	push rax  ; RSP
 	push 0x202	; FLAGS
 	push 0x08	; CS
 	push r8  ; IP for main wrapper of new process
@@ -61,13 +88,17 @@ _initStack:
 	push 13  ; r13
 	push 14  ; r14
 	push 15  ; r15
+	; _switchTo frame returning into _firstRun
+	push _firstRun
+	push 0  ; rbp
+	push 0  ; rbx
+	push 0  ; r12
+	push 0  ; r13
+	push 0  ; r14
+	push 0  ; r15
 
 	mov rax, rsp
 
 	mov rsp, rbp
 	pop rbp
 	ret
-
-_interrupt:
-	int 20h
-	ret
\ No newline at end of file
@@ -1,6 +1,9 @@
 GLOBAL _getHour
 GLOBAL _getMinute
 GLOBAL _getSecond
+GLOBAL _setPIT
+GLOBAL _setPITOneShot
+GLOBAL _readPIT
 
 section .text
 
@@ -61,3 +64,34 @@ statusRegisterB:
 	mov rsp, rbp
   	pop rbp
 	ret
+
+; Programs PIT channel 0 as a rate generator (mode 2) with the divisor in di
+_setPIT:
+	mov al, 34h
+	out 43h, al
+	mov ax, di
+	out 40h, al
+	mov al, ah
+	out 40h, al
+	ret
+
+; Programs PIT channel 0 to interrupt once after the count in di
+_setPITOneShot:
+	mov al, 30h
+	out 43h, al
+	mov ax, di
+	out 40h, al
+	mov al, ah
+	out 40h, al
+	ret
+
+; Returns the current count of PIT channel 0
+_readPIT:
+	mov al, 0h
+	out 43h, al
+	xor rax, rax
+	in al, 40h
+	mov ah, al
+	in al, 40h
+	xchg al, ah
+	ret
@@ -0,0 +1,238 @@
+//       BUDDY SYSTEM MEMORY MANAGER
+
+// *    Managable memory (2^MEM_SIZE_EXP bytes) is split in halves until a
+// *block of the smallest sufficient power of two is obtained.
+// *    Each level corresponds to a certain allocation size and keeps a list
+// *holding only its free blocks; the list links live inside the free blocks
+// *themselves. Level 0 is the whole memory, level LEVELS - 1 the smallest
+// *block (2^MIN_BLOCK_EXP).
+// *    The blocks form a complete binary tree stored as two bitmaps (split,
+// *free). A block's buddy is found by XOR on its offset and a block's level
+// *is found by walking down the split bits, so allocating and freeing are
+// *O(levels) and no per block node is needed.
+
+#include "include/memoryManager.h"
+#include "include/videoDriver.h"
+
+#ifdef BUDDY_MM
+
+#define MIN_BLOCK_EXP 7
+#define LEVELS (MEM_SIZE_EXP - MIN_BLOCK_EXP + 1)
+#define BIGGEST_SIZE_LEVEL 0
+#define SMALLEST_SIZE_LEVEL (LEVELS - 1)
+#define TREE_NODES (((size_t)1 << LEVELS) - 1)
+
+// size of blocks in a given level
+#define level_size(l) (MEM_SIZE >> (l))
+// tree index of the i-th block of a level
+#define tree_index(l, i) ((((size_t)1) << (l)) - 1 + (i))
+
+typedef struct freeBlock {
+  struct freeBlock *next;
+  struct freeBlock *prev;
+} freeBlock;
+
+static uint8_t *const startAddress = (uint8_t *)0x1000000;
+static uint8_t *baseAddress;
+
+static freeBlock *levelArr[LEVELS];
+static uint8_t splitMap[(TREE_NODES + 7) / 8];
+static uint8_t freeMap[(TREE_NODES + 7) / 8];
+
+static int optimalLevel(size_t space);
+static int getBit(uint8_t *map, size_t index);
+static void setBit(uint8_t *map, size_t index, int value);
+static size_t blockIndex(uint8_t *address, int level);
+static void pushBlock(uint8_t *address, int level);
+static void removeBlock(uint8_t *address, int level);
+static int findLevel(uint8_t *address);
+
+void *malloc(size_t space) {
+  if (baseAddress == NULL) {
+    initializeMM();
+  }
+  if (space == 0 || space > MEM_SIZE) {
+    return NULL;
+  }
+  int opLevel = optimalLevel(space);
+  int level = opLevel;
+  while (level >= BIGGEST_SIZE_LEVEL && levelArr[level] == NULL) {
+    level--;
+  }
+  if (level < BIGGEST_SIZE_LEVEL) {
+    return NULL;
+  }
+
+  uint8_t *address = (uint8_t *)levelArr[level];
+  removeBlock(address, level);
+  // Split down to the optimal level, keeping the right halves as free buddies
+  while (level < opLevel) {
+    setBit(splitMap, tree_index(level, blockIndex(address, level)), 1);
+    level++;
+    pushBlock(address + level_size(level), level);
+  }
+  return address;
+}
+
+void *realloc(void *memoryAddress, size_t space) {
+  if (memoryAddress == NULL) {
+    return malloc(space);
+  }
+  int level = findLevel(memoryAddress);
+  if (level < 0) {
+    return NULL;
+  }
+  if (space <= level_size(level) &&
+      (level == SMALLEST_SIZE_LEVEL || space > level_size(level + 1))) {
+    return memoryAddress;
+  }
+  void *retAddress = malloc(space);
+  if (retAddress == NULL) {
+    return NULL;
+  }
+  size_t copy = level_size(level) < space ? level_size(level) : space;
+  memcpy(retAddress, memoryAddress, copy);
+  free(memoryAddress);
+  return retAddress;
+}
+
+void *calloc(size_t space) {
+  void *retAddress = malloc(space);
+  if (retAddress != NULL) {
+    memset(retAddress, 0, space);
+  }
+  return retAddress;
+}
+
+void free(void *memoryAddress) {
+  int level = findLevel(memoryAddress);
+  if (level < 0) {
+    return;
+  }
+  uint8_t *address = memoryAddress;
+  // Merge with the buddy while it is free, moving one level up each time
+  while (level > BIGGEST_SIZE_LEVEL) {
+    size_t offset = address - baseAddress;
+    uint8_t *buddy = baseAddress + (offset ^ level_size(level));
+    if (!getBit(freeMap, tree_index(level, blockIndex(buddy, level)))) {
+      break;
+    }
+    removeBlock(buddy, level);
+    if (buddy < address) {
+      address = buddy;
+    }
+    level--;
+    setBit(splitMap, tree_index(level, blockIndex(address, level)), 0);
+  }
+  pushBlock(address, level);
+}
+
+// ****************     A      ********************
+// ****************     U      ********************
+// ****************     X      ********************
+
+// Sets up the memory manager
+void initializeMM() {
+  baseAddress = startAddress;
+  for (int i = BIGGEST_SIZE_LEVEL; i <= SMALLEST_SIZE_LEVEL; i++) {
+    levelArr[i] = NULL;
+  }
+  memset(splitMap, 0, sizeof(splitMap));
+  memset(freeMap, 0, sizeof(freeMap));
+  pushBlock(baseAddress, BIGGEST_SIZE_LEVEL);
+}
+
+size_t allocatedSize(void *memoryAddress) {
+  int level = findLevel(memoryAddress);
+  return level < 0 ? 0 : level_size(level);
+}
+
+// Returns the highest level (the higher the level the smallest its size)
+// whose block size still holds space
+static int optimalLevel(size_t space) {
+  int level = SMALLEST_SIZE_LEVEL;
+  while (level > BIGGEST_SIZE_LEVEL && level_size(level) < space) {
+    level--;
+  }
+  return level;
+}
+
+static int getBit(uint8_t *map, size_t index) {
+  return (map[index / 8] >> (index % 8)) & 1;
+}
+
+static void setBit(uint8_t *map, size_t index, int value) {
+  if (value) {
+    map[index / 8] |= 1 << (index % 8);
+  } else {
+    map[index / 8] &= ~(1 << (index % 8));
+  }
+}
+
+// Position of the block starting at address among the blocks of its level
+static size_t blockIndex(uint8_t *address, int level) {
+  return (size_t)(address - baseAddress) >> (MEM_SIZE_EXP - level);
+}
+
+// Adds a block to its level's free list
+static void pushBlock(uint8_t *address, int level) {
+  freeBlock *block = (freeBlock *)address;
+  block->prev = NULL;
+  block->next = levelArr[level];
+  if (block->next != NULL) {
+    block->next->prev = block;
+  }
+  levelArr[level] = block;
+  setBit(freeMap, tree_index(level, blockIndex(address, level)), 1);
+}
+
+// Deletes a block from its level's free list
+static void removeBlock(uint8_t *address, int level) {
+  freeBlock *block = (freeBlock *)address;
+  if (block->prev == NULL) {
+    levelArr[level] = block->next;
+  } else {
+    block->prev->next = block->next;
+  }
+  if (block->next != NULL) {
+    block->next->prev = block->prev;
+  }
+  setBit(freeMap, tree_index(level, blockIndex(address, level)), 0);
+}
+
+// Given the address of an allocated block returns its level, or -1 if the
+// address is not the start of an allocated block
+static int findLevel(uint8_t *address) {
+  if (baseAddress == NULL || address == NULL || address < baseAddress ||
+      address >= baseAddress + MEM_SIZE) {
+    return -1;
+  }
+  int level = BIGGEST_SIZE_LEVEL;
+  while (level < SMALLEST_SIZE_LEVEL &&
+         getBit(splitMap, tree_index(level, blockIndex(address, level)))) {
+    level++;
+  }
+  size_t offset = address - baseAddress;
+  if ((offset & (level_size(level) - 1)) != 0 ||
+      getBit(freeMap, tree_index(level, blockIndex(address, level)))) {
+    return -1;
+  }
+  return level;
+}
+
+// Given an address, prints the block it starts
+void printNode(uint8_t *address) {
+  int level = findLevel(address);
+  if (level < 0) {
+    printf("Invalid node: this node does not exist or has been freed\n");
+    return;
+  }
+  printf("\n-----\n");
+  printf("content: %s\n", address);
+  printf("address: %d\n", (int)(size_t)address);
+  printf("level: %d\n", level);
+  printf("size: %d\n", (int)level_size(level));
+  printf("----\n");
+}
+
+#endif
@@ -0,0 +1,36 @@
+#include "include/file.h"
+#include <stddef.h>
+#include "include/pipe.h"
+#include "include/slab.h"
+
+static tFile consoleIn = {CONSOLE_IN, NULL, 1};
+static tFile consoleOut = {CONSOLE_OUT, NULL, 1};
+static slabCache_t fileCache;
+
+file_t consoleFile(int type) {
+  return type == CONSOLE_IN ? &consoleIn : &consoleOut;
+}
+
+file_t fileCreate(struct tPipe* pipe) {
+  if (fileCache == NULL) {
+    fileCache = slabCacheCreate("file", sizeof(tFile));
+  }
+  file_t file = slabAlloc(fileCache);
+  if (file == NULL) return NULL;
+  file->type = PIPE_FILE;
+  file->pipe = pipe;
+  file->refs = 1;
+  return file;
+}
+
+void fileGet(file_t file) {
+  if (file->type == PIPE_FILE) file->refs++;
+}
+
+void filePut(file_t file) {
+  if (file->type != PIPE_FILE) return;
+  file->refs--;
+  if (file->refs > 0) return;
+  releasePipe(file->pipe);
+  slabFree(fileCache, file);
+}
@@ -0,0 +1,50 @@
+#include "include/futex.h"
+#include <stdint.h>
+#include "include/list.h"
+#include "include/process.h"
+#include "include/scheduler.h"
+
+#define FUTEX_BUCKETS 64  // power of two, hashes are masked
+
+// Sleepers of every address hashing to the same bucket share its list,
+// each one keeps the address it waits on in futexKey
+static tList buckets[FUTEX_BUCKETS];
+
+static tList* bucketOf(int* address);
+
+void initializeFutexes() {
+  for (int i = 0; i < FUTEX_BUCKETS; i++) {
+    listInit(&buckets[i]);
+  }
+}
+
+// Syscalls run with interrupts disabled, so no wake can slip in between the
+// check of the word and going to sleep
+int futexWait(int* address, int expected) {
+  if (*address != expected) return 1;
+  tProcess* running = getCurrentProcess();
+  running->futexKey = address;
+  waitOn(bucketOf(address));
+  return 0;
+}
+
+int futexWake(int* address, int count) {
+  tList* bucket = bucketOf(address);
+  int woken = 0;
+  tLink* link = bucket->head.next;
+  while (link != &bucket->head && woken < count) {
+    tLink* next = link->next;
+    tProcess* proc = listEntry(link, tProcess, waitLink);
+    if (proc->futexKey == address) {
+      wakeProcess(proc);
+      woken++;
+    }
+    link = next;
+  }
+  return woken;
+}
+
+static tList* bucketOf(int* address) {
+  uint64_t key = (uint64_t)address >> 2;
+  return &buckets[(key ^ (key >> 6)) & (FUTEX_BUCKETS - 1)];
+}
@@ -1,8 +1,8 @@
 #ifndef SYSCDispatcher_H_
 #define SYSCDispatcher_H_
 
-// Handles General Systemcalls
-void syscallDispatcher(uint64_t syscall, uint64_t p1, uint64_t p2, uint64_t p3,
-                       uint64_t p4, uint64_t p5);
+// Handles General Systemcalls, the returned value is left in rax
+uint64_t syscallDispatcher(uint64_t syscall, uint64_t p1, uint64_t p2,
+                           uint64_t p3, uint64_t p4, uint64_t p5);
 
 #endif
@@ -0,0 +1,35 @@
+#ifndef FILE_H
+#define FILE_H
+
+#define CONSOLE_IN 0
+#define CONSOLE_OUT 1
+#define PIPE_FILE 2
+
+struct tPipe;
+
+// Open file shared by every descriptor dup'd from the same one. Descriptor
+// tables point straight at it, so no lookup is needed on each read or write
+typedef struct tFile {
+  int type;
+  struct tPipe* pipe;  // only for PIPE_FILE
+  int refs;            // descriptors pointing at the file
+} tFile;
+
+typedef tFile* file_t;
+
+// Returns the console file of the given type. They live forever, so they
+// are not reference counted
+file_t consoleFile(int type);
+
+// Opens a file on the pipe with a single reference. Returns NULL if there is
+// no memory for it
+file_t fileCreate(struct tPipe* pipe);
+
+// Adds a reference to the file
+void fileGet(file_t file);
+
+// Drops a reference, closing the file (and releasing its pipe end) on the
+// last one
+void filePut(file_t file);
+
+#endif
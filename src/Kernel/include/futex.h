@@ -0,0 +1,18 @@
+#ifndef FUTEX_H
+#define FUTEX_H
+
+// Sleeping and waking keyed by the address of a word in user memory. User
+// code updates the word with atomic instructions and only enters the kernel
+// when it has to sleep (or there may be someone to wake).
+
+// leaves every futex bucket empty
+void initializeFutexes();
+
+// Blocks the running process on address if it still holds expected. Returns
+// 0 after being woken up, 1 right away if the word had already changed
+int futexWait(int* address, int expected);
+
+// Wakes up to count processes sleeping on address and returns how many
+int futexWake(int* address, int count);
+
+#endif
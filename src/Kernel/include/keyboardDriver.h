@@ -1,11 +1,8 @@
 #ifndef KEYBOARD_H
 #define KEYBOARD_H
 
-// Manages calls from the keyboard interruption handler
-// Returns 0 if no key was added to buffer, 1 if a key was added
+// Manages calls from the keyboard interruption handler, handing the typed
+// characters to the tty. Returns 0 if no key was typed, 1 if one was
 int keyboardHandler();
 
-// Returns a char from buffer
-unsigned char getKey();
-
 #endif
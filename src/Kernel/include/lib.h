@@ -14,6 +14,8 @@ unsigned long int rand();
 int read(int fd, char* buffer, int size);
 int write(int fd, char *buffer, int size);
 char *cpuVendor(char *result);
+// Returns the cpu time stamp counter
+uint64_t _rdtsc();
 
 // TEST
 void printf(char* fmt, ...);
@@ -0,0 +1,53 @@
+#ifndef LIST_H
+#define LIST_H
+
+#include <stddef.h>
+
+// Intrusive doubly linked list: the link lives inside the listed object, so
+// adding or removing an element never allocates memory. A list is circular
+// around its head, which makes every operation O(1) (except listSize).
+
+typedef struct tLink {
+  struct tLink* next;
+  struct tLink* prev;
+} tLink;
+
+typedef struct tList {
+  tLink head;
+} tList;
+
+// Given a link, returns the object that contains it
+#define listEntry(link, type, member) \
+  ((type*)((char*)(link) - offsetof(type, member)))
+
+// leaves the list empty
+void listInit(tList* list);
+
+// leaves the link detached from any list
+void linkInit(tLink* link);
+
+// returns 1 if the link belongs to a list, 0 otherwise
+int linkIsLinked(tLink* link);
+
+// returns 1 if the list has no elements, 0 otherwise
+int listIsEmpty(tList* list);
+
+// adds the link at the end of the list
+void listPushBack(tList* list, tLink* link);
+
+// returns the first link of the list without removing it, NULL if empty
+tLink* listFront(tList* list);
+
+// removes the first link of the list and returns it, NULL if empty
+tLink* listPopFront(tList* list);
+
+// detaches the link from the list it belongs to, does nothing if detached
+void listRemove(tLink* link);
+
+// moves every link of from to the end of to, leaving from empty
+void listMoveAll(tList* from, tList* to);
+
+// returns the amount of elements in the list
+int listSize(tList* list);
+
+#endif
@@ -1,6 +1,7 @@
 #ifndef MUTEX_H
 #define MUTEX_H
 #include <stddef.h>
+#include "./list.h"
 #include "./queue.h"
 #include "./process.h"
 
@@ -8,24 +9,27 @@
 
 typedef struct tMutex {
   int value;
-  unsigned long ownerPID;
-  queue_t lockedQueue;
+  tProcess* owner;  // NULL while unlocked
+  tList lockedList;
+  tLink heldLink;  // links the mutex into its owner's heldMutexes
 } tMutex;
 
 typedef tMutex* mutex_t;
 
-typedef struct MutexData {
-  char id[MAX_MUTEX_ID];
-  mutex_t mutex;
-}MutexData;
-
-extern queue_t mutexQueue;
-
 
 mutex_t mutexCreate();
 void mutexDelete(mutex_t mutex);
+// Takes the mutex, blocking until its owner hands it over. While blocked
+// the owner runs with at least the caller's priority
 void mutexLock(mutex_t mutex);
+// Hands the mutex straight to the first waiter (it never looks unlocked in
+// between), or unlocks it if nobody waits
 void mutexUnlock(mutex_t mutex);
-int _mutex_acquire(int * lockValue);
+// Sets the process's priority to the highest of its base priority and the
+// priorities of the processes waiting for its mutexes
+void refreshPriority(tProcess* process);
+// Releases every mutex of an ending process and stops it from lending its
+// priority
+void mutexAbandon(tProcess* process);
 
 #endif
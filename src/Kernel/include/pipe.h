@@ -1,27 +1,46 @@
 #ifndef PIPE_H
 #define PIPE_H
 
-#include "./semaphore.h"
+#include "./list.h"
 #include "./process.h"
+#include "./ring.h"
+
+// Buffer handed over by vmsplice. The pipe owns it until a reader drains it
+// or takes it with splice
+typedef struct tPipePage {
+  tLink link;
+  char* data;
+  int offset;  // bytes already read through readFromPipe
+  int size;
+} tPipePage;
 
 typedef struct tPipe {
-  int id;
-  char* base;
-  long readPos;
-  long writePos;
-  int dataAmount;
-  sem_t dataSem;
-  mutex_t dataMutex;
-  int users;
+  tRing ring;
+  tList readers;  // processes waiting for data, only while empty
+  tList writers;  // processes waiting for space, only while full
+  tList pages;    // spliced buffers, queued behind the ring's data
+  int pageCount;  // buffers in pages
+  int users;  // open files on the pipe
 }tPipe;
 
 typedef tPipe* pipe_t;
 
 void initializePipes();
+// Opens a pipe's read and write ends in the running process. Returns 0, or
+// -1 if they could not be allocated
 int pipe(int fileDescriptors[2]);
-int writeToPipe(int id, char* buffer, int bytes);
-int readFromPipe(int id, char* buffer, int bytes);
-void closeFD(tProcess* process, int fd);
-pipe_t getPipe(int id);
+int writeToPipe(pipe_t pipe, char* buffer, int bytes);
+int readFromPipe(pipe_t pipe, char* buffer, int bytes);
+// Gives a heap buffer to the pipe at fd without copying it, blocking while
+// the pipe already holds too many. The caller must not touch it afterwards.
+// Returns bytes, or -1 (the buffer stays the caller's) if fd is not a pipe,
+// page is not the start of a live heap block of at least bytes, or the
+// pipe is out of memory
+int vmsplice(int fd, char* page, int bytes);
+// Takes the next buffer from the pipe at fd, which the caller must free.
+// Returns its size, or -1 if fd is not a pipe or out of memory
+int splice(int fd, char** page);
+// Called when an open file on the pipe closes, frees it after the last one
+void releasePipe(pipe_t pipe);
 
 #endif
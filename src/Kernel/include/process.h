@@ -2,6 +2,8 @@
 #define PROCESS_H
 
 #include <stdint.h>
+#include "./file.h"
+#include "./list.h"
 
 #define HIGHP 250
 #define MIDP 150
@@ -10,8 +12,16 @@
 
 #define READY 0
 #define BLOCKED 1
+#define ZOMBIE 2  // ended, waiting for its parent to collect the exit status
+
+// processes started by the kernel, nobody waits for them. Never a pid (they
+// start at 0, sysIdle)
+#define NO_PARENT ((unsigned long int)-1)
+#define KILLED_STATUS -1
 
 #define MAX_FD 30
+#define NO_SLOT -1
+#define NO_LEVEL -1
 #define STD_IN 0
 #define STD_OUT 1
 
@@ -19,17 +29,32 @@
 typedef struct tProcess {
   unsigned long int pid;
   unsigned long int parent;
-  int fileDescriptors[MAX_FD];
+  file_t fileDescriptors[MAX_FD];  // NULL when the descriptor is closed
   int maxFD;
   char *name;
   int (*entry)(int, char **argv);
   uint64_t stackBase;
   uint64_t stackTop;
   uint64_t rsp;
-  int priority;
+  int priority;      // tickets, raised above basePriority while inherited
+  int basePriority;  // priority it was given (creation or nice)
   int status;
   int argc;
   char **argv;
+  tLink waitLink;  // links the process into the wait list it is blocked on
+  int schedSlot;   // lottery ticket slot, NO_SLOT while not ready
+  tLink schedLink;  // links the process into its MLFQ ready queue
+  int schedLevel;   // MLFQ level, NO_LEVEL until first scheduled
+  int schedTicks;   // time slices used at the current MLFQ level
+  unsigned long int cpuTicks;  // timer ticks spent running
+  unsigned long int wakeTick;  // tick a sleeping process wakes up at
+  int *futexKey;    // word the process sleeps on while in a futex bucket
+  int exitStatus;   // value returned by its main, KILLED_STATUS if killed
+  tList childExit;  // the process itself while waiting for a child to end
+  tList heldMutexes;          // kernel mutexes the process owns
+  struct tMutex *blockedOn;   // mutex the process is waiting for, if any
+  int semUnits;     // units asked for while blocked on a semaphore
+  struct tSemaphore *semBlockedOn;  // semaphore it waits units from, if any
 } tProcess;
 
 typedef struct tProcessData {
@@ -38,6 +63,7 @@ typedef struct tProcessData {
   char* status;
   int memory;
   char* priority;
+  unsigned long int ticks;
 } tProcessData;
 
 struct tProcess *newProcess(char *name, int (*entry)(int, char **), int argc,
@@ -45,11 +71,21 @@ struct tProcess *newProcess(char *name, int (*entry)(int, char **), int argc,
 
 void initializeProcesses();
 void freeProcess(tProcess* process);
+// Frees the stack and file descriptors, keeping the process until freed
+void releaseProcess(tProcess* process);
+// Returns a child of the process with the given pid (only a zombie one if
+// zombie is 1), NULL if there is none
+tProcess* findChild(unsigned long int parent, int zombie);
 void getProcessData(tProcess* process, tProcessData* data);
 void ps(tProcessData*** psVec, int* size);
 tProcess* getProcess(unsigned long int pid);
-int addFileDescriptor(tProcess* process, int fileDescriptor);
+// Stores the file in the lowest free descriptor and returns it, -1 if the
+// table is full. The file's reference is handed to the process
+int addFileDescriptor(tProcess* process, file_t file);
+// Returns the file behind the descriptor, NULL if it is closed or invalid
+file_t getFile(tProcess* process, int fd);
 void dup(tProcess* process, int fd, int pos);
+void closeFD(tProcess* process, int fd);
 void setMaxFD(tProcess* process);
 
 #endif
@@ -0,0 +1,37 @@
+#ifndef REGISTRY_H
+#define REGISTRY_H
+
+// Kernel namespace of named objects (mutexes, semaphores). Names are found
+// through a hash table, and every open object gets an integer handle that
+// indexes a table, so operations by handle never look at the name. Handles
+// carry a generation, a handle to a removed object stays invalid even after
+// its slot is reused.
+
+#define OBJ_MUTEX 0
+#define OBJ_SEM 1
+
+#define MAX_OBJECT_NAME 30
+#define HANDLE_SLOT_BITS 7
+#define MAX_HANDLES (1 << HANDLE_SLOT_BITS)
+#define NO_HANDLE -1
+
+// leaves the namespace empty
+void initializeRegistry();
+
+// Registers the object under name and returns its handle, NO_HANDLE if the
+// handle table is full or there is no memory
+int registryAdd(char* name, int type, void* object);
+
+// Returns the handle of the object of that type and name, NO_HANDLE if
+// there is none
+int registryFind(char* name, int type);
+
+// Returns the object behind the handle, NULL if the handle is not open or
+// belongs to another type of object
+void* registryGet(int handle, int type);
+
+// Unregisters the handle and returns its object so it can be deleted, NULL
+// if the handle is not open or belongs to another type of object
+void* registryRemove(int handle, int type);
+
+#endif
@@ -0,0 +1,35 @@
+#ifndef RING_H
+#define RING_H
+
+// Byte ring shared by one producer and one consumer without locks. Sizes
+// are powers of two and the positions run freely, so they are masked on
+// every access and head - tail is always the amount of stored bytes. The
+// producer publishes data with a release store of head that the consumer
+// reads with acquire, and the same goes for tail the other way around, so
+// the two sides can run on different processors or in an interrupt.
+
+typedef struct tRing {
+  char* data;
+  unsigned int mask;  // size - 1
+  unsigned int head;  // next position written, only the producer stores it
+  unsigned int tail;  // next position read, only the consumer stores it
+} tRing;
+
+// Uses buffer (size bytes, a power of two) as an empty ring
+void ringInit(tRing* ring, char* buffer, unsigned int size);
+
+// Stored bytes and free space, exact for the calling side
+unsigned int ringCount(tRing* ring);
+unsigned int ringSpace(tRing* ring);
+
+// Producer side. Returns 0 if the ring is full
+int ringPush(tRing* ring, char c);
+// Copies as many bytes as fit and returns how many
+unsigned int ringWrite(tRing* ring, const char* buffer, unsigned int bytes);
+
+// Consumer side. Returns 0 if the ring is empty
+int ringPop(tRing* ring, char* c);
+// Copies up to bytes stored bytes and returns how many
+unsigned int ringRead(tRing* ring, char* buffer, unsigned int bytes);
+
+#endif
@@ -0,0 +1,52 @@
+#ifndef SCHED_POLICY_H
+#define SCHED_POLICY_H
+
+#include "./process.h"
+
+// Scheduling policy is picked at build time (make SCHED=LOTTERY|MLFQ),
+// LOTTERY by default. scheduler.c does the context switching and leaves the
+// choice of the next process to the policy through these functions.
+#if !defined(LOTTERY_SCHED) && !defined(MLFQ_SCHED)
+#define LOTTERY_SCHED
+#endif
+
+// Time slice classes, from the highest priority to idle (see setQuantum)
+#define SLICE_HIGH 0
+#define SLICE_MID 1
+#define SLICE_LOW 2
+#define SLICE_IDLE 3
+#define SLICE_CLASSES 4
+
+// returns the time slice class of a priority
+int sliceClassOf(int priority);
+
+// leaves the policy without ready processes
+void policyInit();
+
+// makes a process ready, does nothing if it already is
+void policyAdd(tProcess* process);
+
+// takes a process out of the ready ones, does nothing if it is not ready
+void policyRemove(tProcess* process);
+
+// returns the amount of ready processes
+int policyReadyCount();
+
+// Returns the ready process to run next. current is the process that was
+// running (NULL if it ended); it is still ready when it was preempted
+tProcess* policyNext(tProcess* current);
+
+// changes the priority of a process, ready or not
+void policySetPriority(tProcess* process, int priority);
+
+// returns the time slice class the process runs with
+int policySliceClass(tProcess* process);
+
+// called when a blocked process is woken up, before it is added back
+void policyWake(tProcess* process);
+
+// returns 1 if the woken process should take the CPU from current right
+// away instead of waiting for current's time slice to end
+int policyPreempts(tProcess* woken, tProcess* current);
+
+#endif
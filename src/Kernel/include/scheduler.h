@@ -2,20 +2,71 @@
 #define SCHEDULER_H
 
 #include <stdint.h>
+#include "./list.h"
 #include "./process.h"
 
 #define READY 0
 #define BLOCKED 1
 
+// waitChild options and pid
+#define WNOHANG 1     // return 0 instead of blocking if no child ended yet
+#define ANY_CHILD -1  // wait for whichever child ends first
+
 void start(int (*entryPoint)(int, char**));
-void lottery(uint64_t rsp);
+// Called on every timer tick with the interrupted stack. Once the running
+// process used up its time slice switches to the process the scheduling
+// policy picks
+void schedule(uint64_t rsp);
+// Gives the rest of the running process's time slice up, it stays ready
+void yield();
+// Sets how many ticks processes of the given priority run before being
+// preempted (MLFQ levels use the priority they start at)
+void setQuantum(int priority, int ticks);
+int getQuantum(int priority);
 void addProcess(tProcess* proc);
 void removeProcess(tProcess* process);
+// Changes the priority (amount of tickets) of a process, scheduled or not
+void setPriority(tProcess* process, int priority);
 tProcess* getCurrentProcess();
 void initStack(tProcess* proc);
 void killProc(unsigned long int pid);
+// Waits for the child with the given pid (or any child) of the running
+// process to end and frees it. Stores its exit status and returns its pid,
+// 0 if WNOHANG was given and no child ended yet, -1 if there is no such child
+long int waitChild(long int pid, int* status, int options);
+// Blocks the running process on the wait list until it is woken up
+void waitOn(tList* waitList);
+// Wakes up the first process of the wait list and returns it (NULL if the
+// list is empty)
+tProcess* wakeOne(tList* waitList);
+// Wakes up every process of the wait list
+void wakeAll(tList* waitList);
+// Takes a blocked process out of its wait list and makes it ready. If the
+// policy says it preempts the running process, the switch happens when the
+// interrupt or syscall that woke it returns
+void wakeProcess(tProcess* proc);
+// Switches to the woken process that preempts the running one, if any.
+// Called before an interrupt handler returns
+void preemptOnIrq();
+// Same for the end of a syscall, the running process stays ready
+void preemptOnSyscall();
+// Directed yield for semaphore and mutex releases: the running process
+// hands the rest of its time slice to proc, which it just woke up, and
+// proc runs next. With handoff off proc only becomes ready and waits to
+// be picked by the policy
+void handOff(tProcess* proc);
+// Turns handoff on or off and returns the previous setting (on by default)
+int setHandoff(int enabled);
+
+// Average cycles spent per scheduler operation, see schedBenchmark
+typedef struct tSchedBench {
+  uint64_t drawCycles;    // drawing a lottery winner
+  uint64_t walkCycles;    // finding the winner walking every ticket range
+  uint64_t addCycles;     // adding a ready process
+  uint64_t removeCycles;  // removing a ready process
+} tSchedBench;
 
-void printProcList();
+void schedBenchmark(int processes, int draws, tSchedBench* result);
 void schedTestDinamic();
 void schedTestStatic(uint64_t initStack);
 void startTest(int (*entryPoint)(int, char**));
@@ -1,29 +1,36 @@
 #ifndef SEMAPHORE_H
 #define SEMAPHORE_H
 
+#include "./list.h"
 #include "./mutex.h"
 #include "./queue.h"
 #define MAX_SEM_ID 30
-typedef struct {
+typedef struct tSemaphore {
   int value;
-  queue_t lockedQueue;
-  mutex_t mutex;
+  tList lockedList;  // waiters in arrival order, each asking for semUnits
 } tSemaphore;
 
 typedef tSemaphore* sem_t;
 
-typedef struct SemData {
-  char id[MAX_SEM_ID];
-  sem_t sem;
-}SemData;
-
-
-extern queue_t semQueue;
-
 sem_t semCreate(int startValue);
 void semDelete(sem_t sem);
 void semWait(sem_t sem);
 void semPost(sem_t sem);
+// Takes count units at once, blocking until all of them are available
+void semWaitN(sem_t sem, int count);
+// Adds count units, waking every waiter they are enough for
+void semPostN(sem_t sem, int count);
 int semGetValue(sem_t sem);
+// Takes an ending process out of the semaphore's queue, so the waiters it
+// was holding back get the units it did not take
+void semAbandon(tProcess* process);
+
+// A semaphore used as a condition variable: only its wait list matters.
+// Unlocks the mutex and blocks until signaled, then locks it again
+void condWait(sem_t cond, mutex_t mutex);
+// Wakes the first process waiting on the condition
+void condSignal(sem_t cond);
+// Wakes every process waiting on the condition
+void condBroadcast(sem_t cond);
 
 #endif
@@ -0,0 +1,37 @@
+#ifndef SLAB_H
+#define SLAB_H
+
+#include <stddef.h>
+
+#define MAX_CACHE_NAME 20
+
+typedef struct tSlabCache* slabCache_t;
+
+typedef struct tSlabStats {
+  char* name;
+  size_t objectSize;
+  int slabs;
+  int objects;  // total objects held by the cache's slabs
+  int inUse;
+  unsigned long allocs;
+  unsigned long frees;
+} tSlabStats;
+
+// Creates a cache of objects of the given size. Objects are carved out of
+// slabs taken from malloc and go back to the cache when freed, so a cache
+// never fragments the heap. Returns NULL if there is not enough memory
+slabCache_t slabCacheCreate(char* name, size_t objectSize);
+
+// Returns a free object from the cache (its content is whatever the previous
+// user left), or NULL if a new slab is needed and there is no memory for it
+void* slabAlloc(slabCache_t cache);
+
+// Returns an object to the cache it was taken from
+void slabFree(slabCache_t cache, void* object);
+
+void slabGetStats(slabCache_t cache, tSlabStats* stats);
+
+// Prints the stats of every cache
+void printSlabs();
+
+#endif
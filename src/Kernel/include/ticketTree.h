@@ -0,0 +1,27 @@
+#ifndef TICKET_TREE_H
+#define TICKET_TREE_H
+
+// Fenwick (binary indexed) tree over process slots: each slot holds the
+// tickets of the process in it, so the owner of any ticket is found, and a
+// slot's tickets are changed, in O(log MAX_SLOTS) without renumbering ranges.
+
+#define MAX_SLOTS 1024  // must be a power of two
+
+typedef struct tTicketTree {
+  int total;
+  int tree[MAX_SLOTS + 1];
+} tTicketTree;
+
+// leaves every slot with 0 tickets
+void ticketTreeInit(tTicketTree* tickets);
+
+// adds delta tickets (may be negative) to the slot
+void ticketTreeAdd(tTicketTree* tickets, int slot, int delta);
+
+// returns the slot owning the given ticket (0 <= ticket < total)
+int ticketTreeFind(tTicketTree* tickets, int ticket);
+
+// returns the amount of tickets in all slots
+int ticketTreeTotal(tTicketTree* tickets);
+
+#endif
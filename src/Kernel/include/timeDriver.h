@@ -1,18 +1,42 @@
 #ifndef TIMEDriver_h
 #define TIMEDriver_h
 
-// Increments ticks for each timer tick interruption
+// Increments ticks for each timer tick interruption and wakes up the
+// processes whose sleep ended
 void timeHandler();
 
+// Sets up the sleep queue, before the first process runs
+void initializeTimer();
+
+// Tickless idle: with nothing to run, the timer is programmed to interrupt
+// once for the next sleeper due instead of on every tick. stopTickless goes
+// back to periodic ticks when the CPU was woken up by another interrupt.
+// Both expect interrupts to be disabled
+void startTickless();
+void stopTickless();
+
+// Timer frequency the kernel sets at boot
+#define TIMER_HZ 100
+
 // Returns current ticks
 int ticksElapsed();
 
+// Reprograms the PIT to interrupt hz times per second (as close as its
+// divisor allows, at least 18.2 Hz)
+void setTimerFrequency(unsigned int hz);
+
+// Returns the current timer frequency in Hz
+unsigned int getTimerFrequency();
+
 // Get time
 unsigned int getHour();
 unsigned int getMinute();
 unsigned int getSecond();
 
-// Waits n ticks
+// Blocks the running process for n ticks
+void sleep(unsigned long n);
+
+// Sleeps n ticks of the PIT default rate (18.2 Hz), whatever the frequency
 void wait(int n);
 
 #endif
@@ -1,8 +1,13 @@
 #ifndef TIMEDriverASM_h
 #define TIMEDriverASM_h
 
+#include <stdint.h>
+
 int _getHour();
 int _getMinute();
 int _getSecond();
+void _setPIT(uint16_t divisor);
+void _setPITOneShot(uint16_t count);
+uint16_t _readPIT();
 
 #endif
@@ -0,0 +1,34 @@
+#ifndef TIMER_WHEEL_H
+#define TIMER_WHEEL_H
+
+#include "./list.h"
+
+// Hierarchical timer wheel of sleeping processes. Level 0 has a slot per
+// tick for the next 64 ticks, each level above a slot per 64 slots of the
+// one below. A process waits in the slot of its wakeTick through its
+// waitLink; when the ticks reach a higher level slot its processes are
+// spread over the lower levels, so adding is O(1) and every process is
+// moved at most once per level.
+
+#define WHEEL_BITS 6
+#define WHEEL_SLOTS (1 << WHEEL_BITS)
+#define WHEEL_LEVELS 4
+// longest sleep a single pass through the wheel covers, in ticks
+#define WHEEL_SPAN ((unsigned long)1 << (WHEEL_BITS * WHEEL_LEVELS))
+
+// leaves the wheel empty with its current tick set to now
+void timerWheelInit(unsigned long now);
+
+// Returns the wait list a process waking up at the given tick blocks on.
+// Sleeps longer than WHEEL_SPAN come out of the wheel early and have to be
+// started again
+tList* timerWheelSlot(unsigned long wakeTick);
+
+// Moves the wheel one tick forward and moves the processes due into expired
+void timerWheelAdvance(tList* expired);
+
+// Returns how many ticks the wheel can move forward at once with nothing to
+// do but on the last one (at most WHEEL_SLOTS)
+unsigned long timerWheelIdleTicks();
+
+#endif
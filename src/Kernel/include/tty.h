@@ -0,0 +1,42 @@
+#ifndef TTY_H
+#define TTY_H
+
+#include <stdint.h>
+
+// Line discipline between the keyboard and the console's standard input.
+// In canonical mode the line being typed is edited (backspace) and echoed
+// in the kernel and reads are handed whole lines; in raw mode every key is
+// readable as soon as it arrives.
+
+// mode flags, raw mode is the absence of TTY_CANONICAL
+#define TTY_RAW 0
+#define TTY_CANONICAL 1  // line editing, reads end at a newline
+#define TTY_ECHO 2       // print the typed keys
+#define TTY_NONBLOCK 4   // reads return 0 instead of waiting for input
+#define TTY_DEFAULT (TTY_CANONICAL | TTY_ECHO)
+
+// leaves the input empty in the default mode
+void initializeTty();
+
+// Called by the keyboard interrupt for every typed character
+void ttyInput(char c);
+
+// Copies up to size available bytes into buffer, at most one line in
+// canonical mode. Blocks while there is nothing to read unless TTY_NONBLOCK
+// is set. Returns the amount of bytes read
+int ttyRead(char* buffer, int size);
+
+// Changes the mode flags and returns the previous ones
+int ttySetMode(int mode);
+
+// Cycles from a key waking the readers up to one of them running again
+typedef struct tTtyLatency {
+  uint64_t samples;
+  uint64_t totalCycles;
+  uint64_t maxCycles;
+} tTtyLatency;
+
+// Copies the latencies measured since the last call and starts over
+void ttyLatency(tTtyLatency* result);
+
+#endif
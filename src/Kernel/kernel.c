@@ -6,6 +6,7 @@
 #include "include/memoryManager.h"
 #include "include/scheduler.h"
 #include "include/semaphore.h"
+#include "include/timeDriver.h"
 #include "include/videoDriver.h"
 
 extern uint8_t text;
@@ -53,6 +54,7 @@ int main() {
   _cli();
   _go_to(getStackBase());
   loadIDT();
+  setTimerFrequency(TIMER_HZ);
 
   start((EntryPoint)sampleCodeModuleAddress); // Run shell
   //testMem();  // Run memory test
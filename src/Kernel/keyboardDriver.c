@@ -1,8 +1,7 @@
 #include "include/keyboardDriver.h"
 #include "include/lib.h"
-#include "include/semaphore.h"
+#include "include/tty.h"
 
-#define BUFFER_SIZE 256
 #define LEFT_SHIFT_SC 42
 #define RIGHT_SHIFT_SC 54
 #define CAPSLOCK_SC 58
@@ -44,23 +43,14 @@
 #define REPAG 0
 #define AVPAG 0
 
-extern sem_t readSem;
-
 // Returns code for pressed key
 unsigned int _getKeyPress();
 
-// Adds character to the buffer as an ascii value
-static void addToBuffer(unsigned char c);
-
 // Decides if the given code is on key pressed or key released
 static int isNotPressed(unsigned char c);
 
 char SHIFT_ON = 0;
 char CAPSLOCK_ON = 0;
-int size = 0;
-char buffer[BUFFER_SIZE] = {0};
-int index = 0;
-int getIndex = 0;
 
 static unsigned char keys[] = {
     0,        ESC,   '1',        '2',  '3',   '4',      '5',         '6',
@@ -115,27 +105,10 @@ int keyboardHandler() {
   } else {
     ascii = keysWithShift[scanCode];
   }
-  addToBuffer(ascii);
+  ttyInput(ascii);
   return 1;
 }
 
-static void addToBuffer(unsigned char ascii) {
-  buffer[index % BUFFER_SIZE] = ascii;
-  index++;
-  if (size < BUFFER_SIZE) size++;
-  semPost(readSem);
-}
-
 static int isNotPressed(unsigned char c) {
   return (c & 0x80);  // return 1 if first bit is 1
 }
-
-unsigned char getKey() {
-  if (size <= 0) {
-    return 0;
-  }
-  unsigned char key = buffer[getIndex % BUFFER_SIZE];
-  getIndex++;
-  size--;
-  return key;
-}
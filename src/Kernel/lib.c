@@ -4,8 +4,9 @@
 #include "./include/process.h"
 #include "./include/scheduler.h"
 #include "./include/pipe.h"
-#include "./include/keyboardDriver.h"
 #include "./include/memoryManager.h"
+#include "./include/semaphore.h"
+#include "./include/tty.h"
 
 #define A 25214903917
 #define C 11
@@ -13,7 +14,6 @@
 static Color WHITE = {255, 255, 255};
 
 #define MOD 50
-extern sem_t readSem;
 
 void *memset(void *destination, int32_t c, uint64_t length) {
   uint8_t chr = (uint8_t)c;
@@ -58,27 +58,25 @@ void *memcpy(void *destination, const void *source, uint64_t length) {
 
 
 int write(int fd, char* buffer, int size) {
-  tProcess* process = getCurrentProcess();
-  int pipeID = process->fileDescriptors[fd];
-  if (pipeID == STD_OUT) {
+  file_t file = getFile(getCurrentProcess(), fd);
+  if (file == NULL) return -1;
+  if (file->type == CONSOLE_OUT) {
     int i;
     for (i = 0; i < size && buffer[i]!= 0; i++) {
       printChar(buffer[i], WHITE);
     }
     return i;
   }
-  return writeToPipe(pipeID, buffer, size);
+  if (file->type == CONSOLE_IN) return 0;
+  return writeToPipe(file->pipe, buffer, size);
 }
 
 int read(int fd, char* buffer, int size) {
-  tProcess* process = getCurrentProcess();
-  int pipeID = process->fileDescriptors[fd];
-  if (pipeID == STD_IN) {
-    semWait(readSem);
-    buffer[0] = getKey();
-    return 1;
-  }
-  return readFromPipe(pipeID, buffer, size);
+  file_t file = getFile(getCurrentProcess(), fd);
+  if (file == NULL) return -1;
+  if (file->type == CONSOLE_IN) return ttyRead(buffer, size);
+  if (file->type == CONSOLE_OUT) return 0;
+  return readFromPipe(file->pipe, buffer, size);
 }
 
 char *decToStr(int num, char *buffer) {
@@ -0,0 +1,58 @@
+#include "./include/list.h"
+
+void listInit(tList* list) {
+  list->head.next = &list->head;
+  list->head.prev = &list->head;
+}
+
+void linkInit(tLink* link) {
+  link->next = link;
+  link->prev = link;
+}
+
+int linkIsLinked(tLink* link) { return link->next != link; }
+
+int listIsEmpty(tList* list) { return list->head.next == &list->head; }
+
+void listPushBack(tList* list, tLink* link) {
+  link->prev = list->head.prev;
+  link->next = &list->head;
+  list->head.prev->next = link;
+  list->head.prev = link;
+}
+
+tLink* listFront(tList* list) {
+  if (listIsEmpty(list)) return NULL;
+  return list->head.next;
+}
+
+tLink* listPopFront(tList* list) {
+  tLink* link = listFront(list);
+  if (link != NULL) listRemove(link);
+  return link;
+}
+
+void listRemove(tLink* link) {
+  link->prev->next = link->next;
+  link->next->prev = link->prev;
+  linkInit(link);
+}
+
+void listMoveAll(tList* from, tList* to) {
+  if (listIsEmpty(from)) return;
+  tLink* first = from->head.next;
+  tLink* last = from->head.prev;
+  first->prev = to->head.prev;
+  last->next = &to->head;
+  to->head.prev->next = first;
+  to->head.prev = last;
+  listInit(from);
+}
+
+int listSize(tList* list) {
+  int size = 0;
+  for (tLink* link = list->head.next; link != &list->head; link = link->next) {
+    size++;
+  }
+  return size;
+}
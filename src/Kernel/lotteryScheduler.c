@@ -0,0 +1,77 @@
+//       LOTTERY SCHEDULING POLICY
+
+// *    Every ready process holds as many tickets as its priority and each
+// *switch draws one ticket at random, so a process gets the CPU in
+// *proportion to its priority.
+// *    Ready processes sit in slots of a Fenwick tree with their tickets, so
+// *drawing the winner, adding, removing and renicing are O(log MAX_SLOTS).
+
+#include "include/schedPolicy.h"
+#include <stddef.h>
+#include "include/lib.h"
+#include "include/ticketTree.h"
+
+#ifdef LOTTERY_SCHED
+
+static tProcess *slots[MAX_SLOTS];
+static int freeSlots[MAX_SLOTS];
+static int freeCount;
+static tTicketTree tickets;
+
+void policyInit() {
+  ticketTreeInit(&tickets);
+  for (int i = 0; i < MAX_SLOTS; i++) {
+    slots[i] = NULL;
+    freeSlots[i] = MAX_SLOTS - 1 - i;
+  }
+  freeCount = MAX_SLOTS;
+}
+
+void policyAdd(tProcess *process) {
+  if (process->schedSlot != NO_SLOT) return;
+  if (freeCount == 0) {
+    // throw error
+    return;
+  }
+  int slot = freeSlots[--freeCount];
+  slots[slot] = process;
+  process->schedSlot = slot;
+  ticketTreeAdd(&tickets, slot, process->priority);
+}
+
+void policyRemove(tProcess *process) {
+  int slot = process->schedSlot;
+  if (slot == NO_SLOT) return;
+  ticketTreeAdd(&tickets, slot, -process->priority);
+  slots[slot] = NULL;
+  freeSlots[freeCount++] = slot;
+  process->schedSlot = NO_SLOT;
+}
+
+int policyReadyCount() { return MAX_SLOTS - freeCount; }
+
+tProcess *policyNext(tProcess *current) {
+  int winner = rand() % ticketTreeTotal(&tickets);
+  return slots[ticketTreeFind(&tickets, winner)];
+}
+
+void policySetPriority(tProcess *process, int priority) {
+  if (process->schedSlot != NO_SLOT) {
+    ticketTreeAdd(&tickets, process->schedSlot, priority - process->priority);
+  }
+  process->priority = priority;
+}
+
+int policySliceClass(tProcess *process) {
+  return sliceClassOf(process->priority);
+}
+
+void policyWake(tProcess *process) {}
+
+// Having blocked is the woken process's credit: it also preempts processes
+// of its own priority, which kept the CPU meanwhile
+int policyPreempts(tProcess *woken, tProcess *current) {
+  return woken->priority >= current->priority;
+}
+
+#endif
@@ -0,0 +1,140 @@
+//       MULTI-LEVEL FEEDBACK QUEUE SCHEDULING POLICY
+
+// *    Ready processes wait in one round robin queue per level and the
+// *first process of the highest non-empty level always runs next.
+// *    A process that keeps being preempted uses up its level's allotment
+// *and is demoted, one that wakes up from a block (semWait, read) is
+// *promoted, so interactive processes stay above CPU bound ones. Every
+// *BOOST_PERIOD switches all ready processes go back to the top level so
+// *none of them starves.
+// *    The idle process has a level of its own below the rest and only runs
+// *when nothing else is ready.
+
+#include "include/schedPolicy.h"
+#include <stddef.h>
+#include "include/list.h"
+
+#ifdef MLFQ_SCHED
+
+// one level per time slice class, idle included
+#define LEVELS SLICE_IDLE
+#define IDLE_LEVEL SLICE_IDLE
+#define BOOST_PERIOD 50
+
+// amount of time slices a process may use at each level before being demoted
+static const int allotment[LEVELS] = {2, 4, 8};
+
+static tList queues[LEVELS + 1];
+static int readyCount;
+static int boostCount;
+
+static int levelOf(int priority);
+static void boost();
+
+void policyInit() {
+  for (int i = 0; i <= IDLE_LEVEL; i++) {
+    listInit(&queues[i]);
+  }
+  readyCount = 0;
+  boostCount = 0;
+}
+
+void policyAdd(tProcess *process) {
+  if (linkIsLinked(&process->schedLink)) return;
+  if (process->schedLevel == NO_LEVEL) {
+    process->schedLevel = levelOf(process->priority);
+  }
+  listPushBack(&queues[process->schedLevel], &process->schedLink);
+  readyCount++;
+}
+
+void policyRemove(tProcess *process) {
+  if (!linkIsLinked(&process->schedLink)) return;
+  listRemove(&process->schedLink);
+  readyCount--;
+}
+
+int policyReadyCount() { return readyCount; }
+
+tProcess *policyNext(tProcess *current) {
+  if (++boostCount >= BOOST_PERIOD) {
+    boost();
+  }
+  // Still ready means it was preempted: charge it a time slice and send it
+  // to the back of its queue
+  if (current != NULL && linkIsLinked(&current->schedLink)) {
+    listRemove(&current->schedLink);
+    if (current->schedLevel < LEVELS - 1 &&
+        ++current->schedTicks >= allotment[current->schedLevel]) {
+      current->schedLevel++;
+      current->schedTicks = 0;
+    }
+    listPushBack(&queues[current->schedLevel], &current->schedLink);
+  }
+  for (int i = 0; i <= IDLE_LEVEL; i++) {
+    tLink *first = listFront(&queues[i]);
+    if (first != NULL) {
+      return listEntry(first, tProcess, schedLink);
+    }
+  }
+  return NULL;
+}
+
+void policySetPriority(tProcess *process, int priority) {
+  process->priority = priority;
+  int level = levelOf(priority);
+  if (process->schedLevel == level) return;
+  process->schedLevel = level;
+  process->schedTicks = 0;
+  if (linkIsLinked(&process->schedLink)) {
+    listRemove(&process->schedLink);
+    listPushBack(&queues[level], &process->schedLink);
+  }
+}
+
+// Each level runs with the time slice of the priority it stands for
+int policySliceClass(tProcess *process) { return process->schedLevel; }
+
+void policyWake(tProcess *process) {
+  if (process->schedLevel > 0 && process->schedLevel < IDLE_LEVEL) {
+    process->schedLevel--;
+  }
+  process->schedTicks = 0;
+}
+
+// policyWake already promoted it, so a process that blocks often gets ahead
+// of a CPU bound one on the same level
+int policyPreempts(tProcess *woken, tProcess *current) {
+  return woken->schedLevel <= current->schedLevel;
+}
+
+// ****************     a      ********************
+// ****************     u      ********************
+// ****************     x      ********************
+
+// Level a process starts at (or is moved to by nice) given its priority
+static int levelOf(int priority) {
+  if (priority == IDLE) return IDLE_LEVEL;
+  if (priority >= HIGHP) return 0;
+  if (priority >= MIDP) return 1;
+  return LEVELS - 1;
+}
+
+// Moves every ready process (but idle) to the top level with a new allotment
+static void boost() {
+  boostCount = 0;
+  for (int i = 1; i < LEVELS; i++) {
+    tLink *link;
+    while ((link = listPopFront(&queues[i])) != NULL) {
+      listPushBack(&queues[0], link);
+    }
+  }
+  for (tLink *link = queues[0].head.next; link != &queues[0].head;
+       link = link->next) {
+    tProcess *process = listEntry(link, tProcess, schedLink);
+    process->schedLevel = 0;
+    process->schedTicks = 0;
+  }
+}
+
+#endif
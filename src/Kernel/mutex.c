@@ -3,45 +3,107 @@
 #include "include/memoryManager.h"
 #include "include/process.h"
 #include "include/scheduler.h"
+#include "include/slab.h"
 
 int _mutexAcquire(int* mutexValue);
-queue_t mutexQueue;
-void _interrupt();
+static slabCache_t mutexCache;
+
+static void takeOwnership(mutex_t mutex, tProcess* process);
+static void lendPriority(mutex_t mutex, int priority);
 
 mutex_t mutexCreate() {
-  mutex_t m = malloc(sizeof(tMutex));
+  if (mutexCache == NULL) {
+    mutexCache = slabCacheCreate("mutex", sizeof(tMutex));
+  }
+  mutex_t m = slabAlloc(mutexCache);
+  if (m == NULL) return NULL;
   m->value = 0;
-  m->ownerPID = 0;
-  m->lockedQueue = queueCreate(sizeof(tProcess*));
+  m->owner = NULL;
+  listInit(&m->lockedList);
+  linkInit(&m->heldLink);
   return m;
 }
 
 void mutexDelete(mutex_t mutex) {
-  queueFree(mutex->lockedQueue);
-  free(mutex);
+  tProcess* owner = mutex->owner;
+  if (owner != NULL) {
+    listRemove(&mutex->heldLink);
+    refreshPriority(owner);
+  }
+  slabFree(mutexCache, mutex);
 }
 
+// Called from syscalls, which run with interrupts disabled: no unlock can
+// slip in between the failed acquire and blocking
 void mutexLock(mutex_t mutex) {
   tProcess* running = getCurrentProcess();
   if (!_mutexAcquire(&(mutex->value))) {
-    mutex->ownerPID = running->pid;
-  } else {
-    queueOffer(mutex->lockedQueue, &running);
-    removeProcess(running);
-    running->status = BLOCKED;
-    _interrupt();
+    takeOwnership(mutex, running);
+    return;
   }
+  running->blockedOn = mutex;
+  lendPriority(mutex, running->priority);
+  waitOn(&mutex->lockedList);
+  // mutexUnlock already made this process the owner
 }
 
 void mutexUnlock(mutex_t mutex) {
-  if (queueSize(mutex->lockedQueue) != 0) {
-    tProcess* proc = NULL;
-    queuePoll(mutex->lockedQueue, &proc);
-    mutex->ownerPID = proc->pid;
-    proc->status = READY;
-    addProcess(proc);
-  } else {
-    mutex->ownerPID = 0;
-  }
-  mutex->value = 0;
+  tProcess* owner = mutex->owner;
+  if (owner == NULL) return;
+  listRemove(&mutex->heldLink);
+  mutex->owner = NULL;
+  refreshPriority(owner);
+  tProcess* next = wakeOne(&mutex->lockedList);
+  if (next == NULL) {
+    mutex->value = 0;
+    return;
+  }
+  next->blockedOn = NULL;
+  takeOwnership(mutex, next);
+  handOff(next);
+}
+
+void refreshPriority(tProcess* process) {
+  int priority = process->basePriority;
+  tList* held = &process->heldMutexes;
+  for (tLink* m = held->head.next; m != &held->head; m = m->next) {
+    tList* waiters = &listEntry(m, tMutex, heldLink)->lockedList;
+    for (tLink* w = waiters->head.next; w != &waiters->head; w = w->next) {
+      tProcess* waiter = listEntry(w, tProcess, waitLink);
+      if (waiter->priority > priority) priority = waiter->priority;
+    }
+  }
+  if (priority != process->priority) setPriority(process, priority);
+}
+
+void mutexAbandon(tProcess* process) {
+  if (process->blockedOn != NULL) {
+    listRemove(&process->waitLink);
+    if (process->blockedOn->owner != NULL) {
+      refreshPriority(process->blockedOn->owner);
+    }
+    process->blockedOn = NULL;
+  }
+  tLink* link;
+  while ((link = listFront(&process->heldMutexes)) != NULL) {
+    mutexUnlock(listEntry(link, tMutex, heldLink));
+  }
+}
+
+static void takeOwnership(mutex_t mutex, tProcess* process) {
+  mutex->owner = process;
+  listPushBack(&process->heldMutexes, &mutex->heldLink);
+  // Whoever still waits now waits for the new owner
+  refreshPriority(process);
+}
+
+// Raises the owner to priority, and so on along the chain of owners blocked
+// on other mutexes
+static void lendPriority(mutex_t mutex, int priority) {
+  while (mutex != NULL && mutex->owner != NULL &&
+         mutex->owner->priority < priority) {
+    tProcess* owner = mutex->owner;
+    setPriority(owner, priority);
+    mutex = owner->blockedOn;
+  }
 }
@@ -1,5 +1,6 @@
 #include <stddef.h>
 #include "include/nice.h"
+#include "include/mutex.h"
 #include "include/process.h"
 #include "include/scheduler.h"
 
@@ -7,8 +8,7 @@ void nice(unsigned long int pid, int priority) {
   tProcess* aux;
   aux = getProcess(pid);
   if (aux != NULL) {
-    removeProcess(aux);
-    aux->priority = priority;
-    addProcess(aux);
+    aux->basePriority = priority;
+    refreshPriority(aux);
   }
 }
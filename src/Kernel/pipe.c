@@ -2,112 +2,191 @@
 #include "include/lib.h"
 #include "include/memoryManager.h"
 #include "include/process.h"
-#include "include/queue.h"
 #include "include/scheduler.h"
-#include "include/semaphore.h"
+#include "include/slab.h"
 
-#define PIPE_MEM 4096  // 4k
+#define PIPE_MEM 4096  // 4k, power of two
+#define PIPE_MAX_PAGES 16  // spliced pages queued before vmsplice blocks
 
-static queue_t pipeQueue;
-static int pipeID;
+static slabCache_t pipeCache;
+static slabCache_t pageCache;
 
 static void freePipe(pipe_t pipe);
-static int cmp(void* a, void* b);
+static int readFromPage(pipe_t pipe, char* buffer, int bytes);
+static void popPage(pipe_t pipe);
+static pipe_t fdPipe(int fd);
+static int min(int a, int b);
 
 void initializePipes() {
-  pipeID = 2;
-  // free pipe queue
+  if (pipeCache == NULL) {
+    pipeCache = slabCacheCreate("pipe", sizeof(tPipe));
+    pageCache = slabCacheCreate("pipePage", sizeof(tPipePage));
+  }
 }
 
 int pipe(int fileDescriptors[2]) {
-  if (pipeQueue == NULL) {
-    pipeQueue = queueCreate(sizeof(sem_t));
+  pipe_t newPipe = slabAlloc(pipeCache);
+  char* data = malloc(PIPE_MEM);
+  if (newPipe == NULL || data == NULL) {
+    if (newPipe != NULL) slabFree(pipeCache, newPipe);
+    if (data != NULL) free(data);
+    return -1;
+  }
+  ringInit(&newPipe->ring, data, PIPE_MEM);
+  listInit(&newPipe->readers);
+  listInit(&newPipe->writers);
+  listInit(&newPipe->pages);
+  newPipe->pageCount = 0;
+  file_t ends[2];
+  newPipe->users = 0;
+  for (int i = 0; i < 2; i++) {
+    ends[i] = fileCreate(newPipe);
+    if (ends[i] != NULL) newPipe->users++;
   }
-  pipe_t newPipe = malloc(sizeof(tPipe));
-  newPipe->id = pipeID++;
-  newPipe->base = malloc(PIPE_MEM);
-  newPipe->readPos = newPipe->writePos = 0;
-  newPipe->dataSem = semCreate(0);
-  newPipe->dataMutex = mutexCreate();
-  newPipe->dataAmount = 0;
-  newPipe->users = 2;
   tProcess* process = getCurrentProcess();
-  fileDescriptors[0] = addFileDescriptor(process, newPipe->id);
-  fileDescriptors[1] = addFileDescriptor(process, newPipe->id);
-  queueOffer(pipeQueue, &newPipe);
-  return 0;
+  int fds[2] = {-1, -1};
+  if (ends[0] != NULL && ends[1] != NULL) {
+    fds[0] = addFileDescriptor(process, ends[0]);
+    if (fds[0] != -1) fds[1] = addFileDescriptor(process, ends[1]);
+  }
+  if (fds[1] != -1) {
+    fileDescriptors[0] = fds[0];
+    fileDescriptors[1] = fds[1];
+    return 0;
+  }
+  // Undo: the last file released frees the pipe
+  if (newPipe->users == 0) freePipe(newPipe);
+  for (int i = 0; i < 2; i++) {
+    if (fds[i] != -1) {
+      closeFD(process, fds[i]);
+    } else if (ends[i] != NULL) {
+      filePut(ends[i]);
+    }
+  }
+  return -1;
 }
 
-int readFromPipe(int id, char* buffer, int bytes) {
-  pipe_t pipe = getPipe(id);
-  semWait(pipe->dataSem);
-  mutexLock(pipe->dataMutex);
-  if (pipe == NULL) {
-    // error*/
-    mutexUnlock(pipe->dataMutex);
-    return 0;
+// Syscalls run with interrupts disabled, so a transfer is atomic unless the
+// process blocks
+int readFromPipe(pipe_t pipe, char* buffer, int bytes) {
+  if (pipe == NULL || bytes <= 0) return 0;
+  while (ringCount(&pipe->ring) == 0 && listIsEmpty(&pipe->pages)) {
+    waitOn(&pipe->readers);
   }
-  int i;
-  for (i = 0; i < bytes && pipe->dataAmount > 0; i++) {
-    pipe->readPos = pipe->readPos % PIPE_MEM;
-    buffer[i] = pipe->base[pipe->readPos++];
-    pipe->dataAmount--;
+  if (ringCount(&pipe->ring) == 0) return readFromPage(pipe, buffer, bytes);
+  int full = ringSpace(&pipe->ring) == 0;
+  int count = ringRead(&pipe->ring, buffer, bytes);
+  // Writers only wait while the ring is full
+  if (full) wakeAll(&pipe->writers);
+  return count;
+}
+
+// Blocks while the ring is full until every byte was written. Spliced pages
+// must be read first so the bytes keep their order
+int writeToPipe(pipe_t pipe, char* buffer, int bytes) {
+  if (pipe == NULL) return 0;
+  int written = 0;
+  while (written < bytes) {
+    while (ringSpace(&pipe->ring) == 0 || !listIsEmpty(&pipe->pages)) {
+      waitOn(&pipe->writers);
+    }
+    int empty = ringCount(&pipe->ring) == 0;
+    written += ringWrite(&pipe->ring, buffer + written, bytes - written);
+    // Readers only wait while the ring is empty
+    if (empty) wakeAll(&pipe->readers);
   }
-  mutexUnlock(pipe->dataMutex);
-  return i;
+  return written;
 }
 
-int writeToPipe(int id, char* buffer, int bytes) {
-  pipe_t pipe = getPipe(id);
-  mutexLock(pipe->dataMutex);
-  if (pipe == NULL) {
-    // error
-    mutexUnlock(pipe->dataMutex);
-    return 0;
+int vmsplice(int fd, char* page, int bytes) {
+  pipe_t pipe = fdPipe(fd);
+  if (pipe == NULL) return -1;
+  if (bytes <= 0) return 0;
+  // The pipe frees the buffer later, so it must be a whole heap block
+  if (allocatedSize(page) < (size_t)bytes) return -1;
+  while (pipe->pageCount >= PIPE_MAX_PAGES) {
+    waitOn(&pipe->writers);
   }
-  int i;
-  for (i = 0; i < bytes; i++) {
-    pipe->writePos = pipe->writePos % PIPE_MEM;
-    pipe->base[pipe->writePos++] = buffer[i];
-    pipe->dataAmount++;
+  tPipePage* newPage = slabAlloc(pageCache);
+  if (newPage == NULL) return -1;
+  linkInit(&newPage->link);
+  newPage->data = page;
+  newPage->offset = 0;
+  newPage->size = bytes;
+  if (ringCount(&pipe->ring) == 0 && listIsEmpty(&pipe->pages)) {
+    wakeAll(&pipe->readers);
   }
-  if (bytes > 0 && semGetValue(pipe->dataSem) == 0) semPost(pipe->dataSem);
-  mutexUnlock(pipe->dataMutex);
-  return i;
+  listPushBack(&pipe->pages, &newPage->link);
+  pipe->pageCount++;
+  return bytes;
 }
 
-pipe_t getPipe(int id) {
-  if (id < 2) return NULL;
-  pipe_t pipe;
-  queueResetIter(pipeQueue);
-  while (queueGetNext(pipeQueue, &pipe) == 0) {
-    if (id == pipe->id) {
-      return pipe;
-    }
+// Bytes still in the ring are copied once into a new buffer, pages go
+// through untouched
+int splice(int fd, char** page) {
+  pipe_t pipe = fdPipe(fd);
+  if (pipe == NULL) return -1;
+  while (ringCount(&pipe->ring) == 0 && listIsEmpty(&pipe->pages)) {
+    waitOn(&pipe->readers);
+  }
+  if (ringCount(&pipe->ring) > 0) {
+    int bytes = ringCount(&pipe->ring);
+    *page = malloc(bytes);
+    if (*page == NULL) return -1;
+    return readFromPipe(pipe, *page, bytes);
   }
-  return NULL;
+  tPipePage* front = listEntry(listFront(&pipe->pages), tPipePage, link);
+  int bytes = front->size - front->offset;
+  if (front->offset == 0) {
+    *page = front->data;
+    front->data = NULL;
+  } else {
+    *page = malloc(bytes);
+    if (*page == NULL) return -1;
+    memcpy(*page, front->data + front->offset, bytes);
+  }
+  popPage(pipe);
+  return bytes;
 }
 
-void closeFD(tProcess* process, int fd) {
-  int pipeID = process->fileDescriptors[fd];
-  if (pipeID < 2) return;
-  process->fileDescriptors[fd] = -1;
-  pipe_t pipe = getPipe(pipeID);
+void releasePipe(pipe_t pipe) {
   pipe->users--;
-  if (fd == process->maxFD) setMaxFD(process);
   if (pipe->users == 0) freePipe(pipe);
 }
 
 static void freePipe(pipe_t pipe) {
-  queueRemove(pipeQueue, cmp, &pipe);
-  free(pipe->base);
-  semDelete(pipe->dataSem);
-  mutexDelete(pipe->dataMutex);
-  free(pipe);
+  free(pipe->ring.data);
+  while (!listIsEmpty(&pipe->pages)) {
+    popPage(pipe);
+  }
+  slabFree(pipeCache, pipe);
 }
 
-static int cmp(void* a, void* b) {
-  pipe_t p1 = *((pipe_t*)a);
-  pipe_t p2 = *((pipe_t*)b);
-  return p1->id - p2->id;
+static int readFromPage(pipe_t pipe, char* buffer, int bytes) {
+  tPipePage* front = listEntry(listFront(&pipe->pages), tPipePage, link);
+  int count = min(bytes, front->size - front->offset);
+  memcpy(buffer, front->data + front->offset, count);
+  front->offset += count;
+  if (front->offset == front->size) popPage(pipe);
+  return count;
 }
+
+// Releases the first spliced page, letting vmsplice in again once there is
+// room and writes once all are gone
+static void popPage(pipe_t pipe) {
+  tPipePage* front = listEntry(listPopFront(&pipe->pages), tPipePage, link);
+  free(front->data);
+  slabFree(pageCache, front);
+  pipe->pageCount--;
+  if (pipe->pageCount == 0 || pipe->pageCount == PIPE_MAX_PAGES - 1) {
+    wakeAll(&pipe->writers);
+  }
+}
+
+static pipe_t fdPipe(int fd) {
+  file_t file = getFile(getCurrentProcess(), fd);
+  if (file == NULL || file->type != PIPE_FILE) return NULL;
+  return file->pipe;
+}
+
+static int min(int a, int b) { return a < b ? a : b; }
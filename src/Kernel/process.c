@@ -2,9 +2,12 @@
 #include <stddef.h>
 #include "include/lib.h"
 #include "include/memoryManager.h"
+#include "include/mutex.h"
+#include "include/semaphore.h"
 #include "include/scheduler.h"
 #include "include/videoDriver.h"
 #include "include/pipe.h"
+#include "include/slab.h"
 
 #define DEFAULT_PROC_MEM 4096  // 8k
 
@@ -13,17 +16,17 @@ typedef struct tPList {
   struct tPList* next;
 } tPList;
 
-void _cli();
-void _sti();
-static void addP(tProcess* process);
+static int addP(tProcess* process);
 static tPList* removeP(tPList* node, tProcess* process);
 
 static long int id;
 static tPList* list;
+static slabCache_t processCache;
+static slabCache_t pListCache;
 
 tProcess* newProcess(char* name, int (*entry)(int, char**), int argc,
                      char** argv, int priority) {
-  tProcess* newP = malloc(sizeof(tProcess));
+  tProcess* newP = slabAlloc(processCache);
   if (newP == NULL) {
     // throw error
     return NULL;
@@ -31,14 +34,14 @@ tProcess* newProcess(char* name, int (*entry)(int, char**), int argc,
   newP->pid = id++;
   tProcess* running = getCurrentProcess();
   if (running == NULL) {
-    newP->parent = 0;
+    newP->parent = NO_PARENT;
   } else {
     newP->parent = running->pid;
   }
-  newP->fileDescriptors[0] = 0;
-  newP->fileDescriptors[1] = 1;
+  newP->fileDescriptors[STD_IN] = consoleFile(CONSOLE_IN);
+  newP->fileDescriptors[STD_OUT] = consoleFile(CONSOLE_OUT);
   for (int i = 2; i < MAX_FD; i++) {
-    newP->fileDescriptors[i] = -1;
+    newP->fileDescriptors[i] = NULL;
   }
   newP->maxFD = 1;
   // newP->name = malloc(sizeof(strlen(name) + 1));
@@ -47,31 +50,55 @@ tProcess* newProcess(char* name, int (*entry)(int, char**), int argc,
   newP->entry = entry;
   newP->argc = argc;
   newP->argv = argv;
-  newP->stackBase = (uint64_t)malloc(DEFAULT_PROC_MEM) + DEFAULT_PROC_MEM - 1;
-  if ((void*)newP->stackBase == NULL) {
+  void* stack = malloc(DEFAULT_PROC_MEM);
+  if (stack == NULL) {
     // throw error
+    slabFree(processCache, newP);
     return NULL;
   }
-  newP->stackTop = newP->stackBase - DEFAULT_PROC_MEM + 1;
+  newP->stackTop = (uint64_t)stack;
+  newP->stackBase = newP->stackTop + DEFAULT_PROC_MEM - 1;
   newP->rsp = newP->stackBase;
   newP->priority = priority;
+  newP->basePriority = priority;
   newP->status = READY;
-  addP(newP);
+  linkInit(&newP->waitLink);
+  newP->schedSlot = NO_SLOT;
+  linkInit(&newP->schedLink);
+  newP->schedLevel = NO_LEVEL;
+  newP->schedTicks = 0;
+  newP->cpuTicks = 0;
+  newP->wakeTick = 0;
+  newP->futexKey = NULL;
+  newP->exitStatus = 0;
+  listInit(&newP->childExit);
+  listInit(&newP->heldMutexes);
+  newP->blockedOn = NULL;
+  newP->semUnits = 0;
+  newP->semBlockedOn = NULL;
+  if (!addP(newP)) {
+    free(stack);
+    slabFree(processCache, newP);
+    return NULL;
+  }
   return newP;
 }
 
-static void addP(tProcess* process) {
-  tPList* aux = malloc(sizeof(tPList));
+// Returns 0 if there is no memory for the list node
+static int addP(tProcess* process) {
+  tPList* aux = slabAlloc(pListCache);
+  if (aux == NULL) return 0;
   aux->process = process;
   aux->next = list;
   list = aux;
+  return 1;
 }
 
 static tPList* removeP(tPList* node, tProcess* process) {
   if (node == NULL) return NULL;
   if (node->process == process) {
     tPList* aux = node->next;
-    free(node);
+    slabFree(pListCache, node);
     return aux;
   }
   node->next = removeP(node->next, process);
@@ -81,18 +108,44 @@ static tPList* removeP(tPList* node, tProcess* process) {
 void initializeProcesses() {
   id = 0;
   list = NULL;
+  if (processCache == NULL) {
+    processCache = slabCacheCreate("process", sizeof(tProcess));
+    pListCache = slabCacheCreate("processList", sizeof(tPList));
+  }
 }
 
 void freeProcess(tProcess* process) {
   if (process == NULL) return;
-  _cli();
   list = removeP(list, process);
-  _sti();
+  listRemove(&process->waitLink);
+  listRemove(&process->schedLink);
+  releaseProcess(process);
+  slabFree(processCache, process);
+}
+
+void releaseProcess(tProcess* process) {
+  if (process->stackTop == 0) return;
   free((tProcess*)process->stackTop);
+  process->stackTop = 0;
+  process->stackBase = 0;
+  mutexAbandon(process);
+  semAbandon(process);
   for (int i = 0; i <= process->maxFD; i++) {
     closeFD(process, i);
   }
-  free(process);
+}
+
+tProcess* findChild(unsigned long int parent, int zombie) {
+  tPList* aux = list;
+  while (aux != NULL) {
+    tProcess* process = aux->process;
+    if (process->parent == parent && process->pid != parent &&
+        (!zombie || process->status == ZOMBIE)) {
+      return process;
+    }
+    aux = aux->next;
+  }
+  return NULL;
 }
 
 void getProcessData(tProcess* process, tProcessData* data) {
@@ -100,8 +153,11 @@ void getProcessData(tProcess* process, tProcessData* data) {
   memcpy(data->name, process->name, strlen(process->name) + 1);
   data->memory = process->stackBase - process->stackTop;
   data->pid = process->pid;
+  data->ticks = process->cpuTicks;
   if (process->status == BLOCKED) {
     data->status = "Blocked";
+  } else if (process->status == ZOMBIE) {
+    data->status = "Zombie ";
   } else {
     data->status = "Ready  ";
   }
@@ -144,10 +200,10 @@ tProcess* getProcess(unsigned long int pid) {
   return NULL;
 }
 
-int addFileDescriptor(tProcess* process, int fileDescriptor) {
-  for (int i = 0; i <= (process->maxFD) + 1; i++) {
-    if (process->fileDescriptors[i] == -1) {
-      process->fileDescriptors[i] = fileDescriptor;
+int addFileDescriptor(tProcess* process, file_t file) {
+  for (int i = 0; i <= (process->maxFD) + 1 && i < MAX_FD; i++) {
+    if (process->fileDescriptors[i] == NULL) {
+      process->fileDescriptors[i] = file;
       if (i > process->maxFD) process->maxFD = i;
       return i;
     }
@@ -155,20 +211,36 @@ int addFileDescriptor(tProcess* process, int fileDescriptor) {
   return -1;
 }
 
+file_t getFile(tProcess* process, int fd) {
+  if (fd < 0 || fd >= MAX_FD) return NULL;
+  return process->fileDescriptors[fd];
+}
+
+// Makes pos in the process's table share the running process's fd file,
+// closing whatever pos held
 void dup(tProcess* process, int fd, int pos) {
-  tProcess* running = getCurrentProcess();
-  int pipeID = running->fileDescriptors[fd];
-  pipe_t pipe = getPipe(pipeID);
-  if (pipe != NULL) pipe->users++;
-  process->fileDescriptors[pos] = pipeID;
+  file_t file = getFile(getCurrentProcess(), fd);
+  if (file == NULL || pos < 0 || pos >= MAX_FD) return;
+  fileGet(file);
+  closeFD(process, pos);
+  process->fileDescriptors[pos] = file;
   if (pos > process->maxFD) process->maxFD = pos;
 }
 
+void closeFD(tProcess* process, int fd) {
+  file_t file = getFile(process, fd);
+  if (file == NULL) return;
+  process->fileDescriptors[fd] = NULL;
+  if (fd == process->maxFD) setMaxFD(process);
+  filePut(file);
+}
+
 void setMaxFD(tProcess* process) {
   for (int i = process->maxFD; i >= 0; i--) {
-    if (process->fileDescriptors[i] != -1) {
+    if (process->fileDescriptors[i] != NULL) {
       process->maxFD = i;
       return;
     }
   }
+  process->maxFD = -1;
 }
@@ -1,12 +1,17 @@
 #include "./include/queue.h"
 #include "./include/lib.h"
 #include "./memoryManager.h"
+#include "./include/slab.h"
 // TESTS
 #include "./include/pipe.h"
 
+// Elements up to this size are stored inside their node
+#define INLINE_DATA 16
+
 typedef struct Node {
   void* data;
   struct Node* next;
+  char inlineData[INLINE_DATA];
 } Node;
 
 typedef struct QueueStruct {
@@ -17,8 +22,17 @@ typedef struct QueueStruct {
   Node* current;
 } QueueStruct;
 
+static slabCache_t queueCache;
+static slabCache_t nodeCache;
+
+static void freeNode(Node* node);
+
 queue_t queueCreate(size_t bytes) {
-  queue_t queue = malloc(sizeof(QueueStruct));
+  if (queueCache == NULL) {
+    queueCache = slabCacheCreate("queue", sizeof(QueueStruct));
+    nodeCache = slabCacheCreate("queueNode", sizeof(Node));
+  }
+  queue_t queue = slabAlloc(queueCache);
   if (queue == NULL) return queue;
   queue->bytes = bytes;
   queue->size = 0;
@@ -30,9 +44,16 @@ queue_t queueCreate(size_t bytes) {
 
 int queueOffer(queue_t queue, void* elem) {
   if (queue == NULL) return 1;
-  Node* newNode = malloc(sizeof(Node));
-  void* newData = malloc(sizeof(queue->bytes));
-  if (newNode == NULL || newData == NULL) return 2;
+  Node* newNode = slabAlloc(nodeCache);
+  if (newNode == NULL) return 2;
+  void* newData = newNode->inlineData;
+  if (queue->bytes > INLINE_DATA) {
+    newData = malloc(queue->bytes);
+    if (newData == NULL) {
+      slabFree(nodeCache, newNode);
+      return 2;
+    }
+  }
   memcpy(newData, elem, queue->bytes);
   newNode->next = NULL;
   newNode->data = newData;
@@ -55,8 +76,7 @@ int queuePoll(queue_t queue, void* ret) {
   if (queue->current == queue->first) {
     queue->current = queue->first->next;
   }
-  free(queue->first->data);
-  free(queue->first);
+  freeNode(queue->first);
   queue->size--;
   queue->first = aux;
   return 0;
@@ -66,12 +86,11 @@ void queueFree(queue_t queue) {
   Node* aux;
   while (queue->first != NULL) {
     aux = queue->first->next;
-    free(queue->first->data);
-    free(queue->first);
+    freeNode(queue->first);
     queue->first = aux;
   }
 
-  free(queue);
+  slabFree(queueCache, queue);
 }
 int queueGetNext(queue_t queue, void* ret) {
   if (queue == NULL) return 1;
@@ -106,8 +125,9 @@ int queueRemove(queue_t queue, int (*cmp)(void*, void*), void* elem) {
 
   Node* next = queue->first->next;
   if ((*cmp)(queue->first->data, elem) == 0) {
-    free(queue->first->data);
-    free(queue->first);
+    // Nodes are reused, so no pointer may be left on the removed one
+    if (queue->current == queue->first) queue->current = next;
+    freeNode(queue->first);
     queue->first = next;
     queue->size--;
     return 0;
@@ -117,8 +137,9 @@ int queueRemove(queue_t queue, int (*cmp)(void*, void*), void* elem) {
   while (aux->next != NULL) {
     if ((*cmp)(aux->next->data, elem) == 0) {
       Node* aux2 = aux->next->next;
-      free(aux->next->data);
-      free(aux->next);
+      if (queue->current == aux->next) queue->current = aux2;
+      if (queue->last == aux->next) queue->last = aux;
+      freeNode(aux->next);
       aux->next = aux2;
       queue->size--;
       return 0;
@@ -138,3 +159,8 @@ int queueSize(queue_t queue) {
   if (queue == NULL) return 0;
   return queue->size;
 }
+
+static void freeNode(Node* node) {
+  if (node->data != node->inlineData) free(node->data);
+  slabFree(nodeCache, node);
+}
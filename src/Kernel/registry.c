@@ -0,0 +1,116 @@
+#include "include/registry.h"
+#include <stddef.h>
+#include <stdint.h>
+#include "include/lib.h"
+#include "include/list.h"
+#include "include/memoryManager.h"
+
+#define BUCKETS 64  // power of two, hashes are masked
+// A handle is its table slot plus, above it, how many times the slot was
+// reused, so a handle kept after its object was removed matches nothing
+#define GENERATION_MASK 0xFFFFFF  // keeps handles positive
+#define slotOf(handle) ((handle) & (MAX_HANDLES - 1))
+
+typedef struct tNamedObject {
+  char name[MAX_OBJECT_NAME];
+  int type;
+  void* object;
+  int handle;  // slot and generation
+  tLink hashLink;  // chains the object in its name's bucket
+} tNamedObject;
+
+static tList buckets[BUCKETS];
+static tNamedObject* handles[MAX_HANDLES];
+static int generations[MAX_HANDLES];
+
+static tList* bucketOf(char* name, int type);
+static int sameName(char* stored, char* name);
+static tNamedObject* getEntry(int handle, int type);
+
+void initializeRegistry() {
+  for (int i = 0; i < BUCKETS; i++) {
+    listInit(&buckets[i]);
+  }
+  for (int i = 0; i < MAX_HANDLES; i++) {
+    handles[i] = NULL;
+    generations[i] = 0;
+  }
+}
+
+int registryAdd(char* name, int type, void* object) {
+  int slot = 0;
+  while (slot < MAX_HANDLES && handles[slot] != NULL) {
+    slot++;
+  }
+  if (slot == MAX_HANDLES) return NO_HANDLE;
+  tNamedObject* entry = malloc(sizeof(tNamedObject));
+  if (entry == NULL) return NO_HANDLE;
+  int length = strlen(name);
+  if (length >= MAX_OBJECT_NAME) length = MAX_OBJECT_NAME - 1;
+  memcpy(entry->name, name, length);
+  entry->name[length] = 0;
+  entry->type = type;
+  entry->object = object;
+  entry->handle = slot | (generations[slot] << HANDLE_SLOT_BITS);
+  linkInit(&entry->hashLink);
+  listPushBack(bucketOf(entry->name, type), &entry->hashLink);
+  handles[slot] = entry;
+  return entry->handle;
+}
+
+int registryFind(char* name, int type) {
+  tList* bucket = bucketOf(name, type);
+  for (tLink* link = bucket->head.next; link != &bucket->head;
+       link = link->next) {
+    tNamedObject* entry = listEntry(link, tNamedObject, hashLink);
+    if (entry->type == type && sameName(entry->name, name)) {
+      return entry->handle;
+    }
+  }
+  return NO_HANDLE;
+}
+
+void* registryGet(int handle, int type) {
+  tNamedObject* entry = getEntry(handle, type);
+  return entry == NULL ? NULL : entry->object;
+}
+
+void* registryRemove(int handle, int type) {
+  tNamedObject* entry = getEntry(handle, type);
+  if (entry == NULL) return NULL;
+  void* object = entry->object;
+  listRemove(&entry->hashLink);
+  int slot = slotOf(handle);
+  handles[slot] = NULL;
+  generations[slot] = (generations[slot] + 1) & GENERATION_MASK;
+  free(entry);
+  return object;
+}
+
+// djb2 over the name (cut like stored names are), mixed with the type
+static tList* bucketOf(char* name, int type) {
+  uint32_t hash = 5381 + type;
+  for (int i = 0; name[i] != 0 && i < MAX_OBJECT_NAME - 1; i++) {
+    hash = hash * 33 + (unsigned char)name[i];
+  }
+  return &buckets[hash & (BUCKETS - 1)];
+}
+
+// Compares a stored name with one that may be longer than the stored cut
+static int sameName(char* stored, char* name) {
+  int i = 0;
+  while (i < MAX_OBJECT_NAME - 1 && stored[i] != 0 && stored[i] == name[i]) {
+    i++;
+  }
+  return i == MAX_OBJECT_NAME - 1 || stored[i] == name[i];
+}
+
+// A stale handle finds its slot taken by a newer generation, or empty
+static tNamedObject* getEntry(int handle, int type) {
+  if (handle < 0) return NULL;
+  tNamedObject* entry = handles[slotOf(handle)];
+  if (entry == NULL || entry->handle != handle || entry->type != type) {
+    return NULL;
+  }
+  return entry;
+}
@@ -0,0 +1,64 @@
+#include "include/ring.h"
+
+#define load(p) __atomic_load_n((p), __ATOMIC_ACQUIRE)
+#define store(p, v) __atomic_store_n((p), (v), __ATOMIC_RELEASE)
+// Inlined or turned into a call to lib.c's memcpy. Not including lib.h keeps
+// the ring buildable next to the host's libc for the tests
+#define copy(d, s, n) __builtin_memcpy((d), (s), (n))
+
+static unsigned int min(unsigned int a, unsigned int b);
+
+void ringInit(tRing* ring, char* buffer, unsigned int size) {
+  ring->data = buffer;
+  ring->mask = size - 1;
+  ring->head = 0;
+  ring->tail = 0;
+}
+
+unsigned int ringCount(tRing* ring) {
+  return load(&ring->head) - load(&ring->tail);
+}
+
+unsigned int ringSpace(tRing* ring) { return ring->mask + 1 - ringCount(ring); }
+
+int ringPush(tRing* ring, char c) {
+  unsigned int head = ring->head;
+  if (head - load(&ring->tail) > ring->mask) return 0;
+  ring->data[head & ring->mask] = c;
+  store(&ring->head, head + 1);
+  return 1;
+}
+
+// At most two copies, up to the end of the buffer and from its start
+unsigned int ringWrite(tRing* ring, const char* buffer, unsigned int bytes) {
+  unsigned int head = ring->head;
+  unsigned int size = ring->mask + 1;
+  unsigned int count = min(bytes, size - (head - load(&ring->tail)));
+  unsigned int pos = head & ring->mask;
+  unsigned int first = min(count, size - pos);
+  copy(ring->data + pos, buffer, first);
+  copy(ring->data, buffer + first, count - first);
+  store(&ring->head, head + count);
+  return count;
+}
+
+int ringPop(tRing* ring, char* c) {
+  unsigned int tail = ring->tail;
+  if (load(&ring->head) == tail) return 0;
+  *c = ring->data[tail & ring->mask];
+  store(&ring->tail, tail + 1);
+  return 1;
+}
+
+unsigned int ringRead(tRing* ring, char* buffer, unsigned int bytes) {
+  unsigned int tail = ring->tail;
+  unsigned int count = min(bytes, load(&ring->head) - tail);
+  unsigned int pos = tail & ring->mask;
+  unsigned int first = min(count, ring->mask + 1 - pos);
+  copy(buffer, ring->data + pos, first);
+  copy(buffer + first, ring->data, count - first);
+  store(&ring->tail, tail + count);
+  return count;
+}
+
+static unsigned int min(unsigned int a, unsigned int b) { return a < b ? a : b; }
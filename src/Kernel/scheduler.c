@@ -5,72 +5,62 @@
 #include "include/memoryManager.h"
 #include "include/mutex.h"
 #include "include/process.h"
+#include "include/registry.h"
 #include "include/semaphore.h"
+#include "include/schedPolicy.h"
+#include "include/ticketTree.h"
 #include "include/timeDriver.h"
+#include "include/tty.h"
 // TESTS
 #include "include/EXCDispatcher.h"
+#include "include/futex.h"
 #include "include/pipe.h"
 #include "include/videoDriver.h"
 
 typedef int (*entryFnc)();
 
-#define QUANTUM 0
-
-sem_t readSem;
-extern queue_t semQueue;
-extern queue_t mutexQueue;
-
-typedef struct tRange {
-  int from;
-  int to;
-} tRange;
-
-typedef struct tPList {
-  struct tProcess *process;
-  struct tRange *tickRange;
-  struct tPList *next;
-} tPList;
 
 void _cli();
 void _sti();
-void _interrupt();
 void _exceptionStackOverflowHandler();
 void _signalEOI();
 
-void _runProcess(
-    uint64_t rsp);  // jumps to rsp stack and continues its program execution
+// Saves the running context's rsp in saveRsp and continues the one at rsp
+void _switchTo(uint64_t *saveRsp, uint64_t rsp);
 uint64_t _initStack(uint64_t stackBase, int (*entry)(int, char **), int argc,
                     char **argv, uint64_t stackRet);
 
-static void freeNode(tPList *curr);
-static tPList *recRem(tPList *list, tProcess *proc, int *procTickets);
-static int runTicket(int ticket, uint64_t rsp);
-static int inRange(tRange *range, int num);
-static void endProcess();
+static void initializeScheduler();
+static void reschedule();
+static void switchNext();
+static void endProcess(int status);
+static void terminate(tProcess *process, int status);
 void run(int (*entry)(int, char **), int argc, char **argv);
-static tProcess *getSchedProcess(unsigned long int pid);
 static void idle();
 
-static tPList *processList;
-static tPList *auxList;
-static int tickets;
-static int winner;
+// Ticks each time slice class runs before being preempted
+static int quanta[SLICE_CLASSES] = {2, 4, 8, 1};
 static int quantum;
 static tProcess *running = NULL;
+// woken process to switch to as soon as possible
+static tProcess *preempt = NULL;
+// ticks preempt runs for, 0 for a slice of its own
+static int donatedSlice;
+static int handoff = 1;
+// Where switchNext saves the context of a process that already ended
+static uint64_t deadRsp;
 
 int testrand();
 
 void start(int (*entryPoint)(int, char **)) {
-  processList = NULL;
-  tickets = 0;
-  quantum = QUANTUM;
-  running = NULL;
+  initializeScheduler();
   initializeMM();
   initializeProcesses();
   initializePipes();
-  mutexQueue = NULL;
-  semQueue = NULL;
-  readSem = semCreate(0);
+  initializeFutexes();
+  initializeTimer();
+  initializeRegistry();
+  initializeTty();
   tProcess *sys_idle = newProcess("sysIdle", (entryFnc)idle, 0, NULL, IDLE);
   tProcess *shell = newProcess("shell", entryPoint, 0, NULL, HIGHP);
   if (shell == NULL) {
@@ -86,133 +76,245 @@ void start(int (*entryPoint)(int, char **)) {
   addProcess(shell);
   addProcess(sys_idle);
   running = shell;
-  _runProcess(running->rsp);
+  _switchTo(&deadRsp, shell->rsp);
 }
 
 void run(int (*entry)(int, char **), int argc, char **argv) {
-  entry(argc, argv);
+  int status = entry(argc, argv);
   _cli();
-  endProcess();
+  endProcess(status);
 }
 
-void endProcess() {
-  removeProcess(running);
-  freeProcess(running);
+static void endProcess(int status) {
+  terminate(running, status);
   running = NULL;
-  _interrupt();
+  reschedule();
 }
 
-void addProcess(tProcess *proc) {
-  tPList *new = malloc(sizeof(*new));
-  if (new == NULL) {
-    // throw error
+// Turns the process into a zombie its parent collects with waitChild, or
+// frees it right away when it has no parent. Its children lose their parent
+static void terminate(tProcess *process, int status) {
+  removeProcess(process);
+  listRemove(&process->waitLink);
+  process->status = ZOMBIE;
+  process->exitStatus = status;
+  releaseProcess(process);
+
+  tProcess *child;
+  while ((child = findChild(process->pid, 1)) != NULL) {
+    freeProcess(child);
   }
-  new->tickRange = malloc(sizeof(*(new->tickRange)));
-  if (new->tickRange == NULL) {
-    // throw error
+  while ((child = findChild(process->pid, 0)) != NULL) {
+    child->parent = NO_PARENT;
+  }
+
+  tProcess *parent =
+      process->parent == NO_PARENT ? NULL : getProcess(process->parent);
+  if (parent == NULL) {
+    freeProcess(process);
+  } else {
+    wakeAll(&parent->childExit);
   }
-  new->process = proc;
-  new->next = processList;
-  new->tickRange->from = tickets;
-  new->tickRange->to = tickets + proc->priority - 1;
-  tickets += proc->priority;
-  processList = new;
 }
 
-static void freeNode(tPList *node) {
-  free(node->tickRange);
-  free(node);
+static void initializeScheduler() {
+  policyInit();
+  quantum = 0;
+  running = NULL;
+  preempt = NULL;
+  donatedSlice = 0;
 }
 
-static tPList *recRem(tPList *list, tProcess *proc, int *procTickets) {
-  if (list == NULL) return NULL;
-  if (list->process == proc) {
-    *procTickets = proc->priority;
-    tickets -= *procTickets;
-    tPList *aux = list->next;
-    freeNode(list);
-    return aux;
-  }
-  list->next = recRem(list->next, proc, procTickets);
-  list->tickRange->from -= *procTickets;
-  list->tickRange->to -= *procTickets;
-  return list;
+// Gives up the CPU right away, without waiting for the time slice to end.
+// Returns once the process is picked again (never if it ended)
+static void reschedule() {
+  _cli();
+  switchNext();
+}
+
+void yield() { reschedule(); }
+
+int sliceClassOf(int priority) {
+  if (priority == IDLE) return SLICE_IDLE;
+  if (priority >= HIGHP) return SLICE_HIGH;
+  if (priority >= MIDP) return SLICE_MID;
+  return SLICE_LOW;
 }
 
+void setQuantum(int priority, int ticks) {
+  if (ticks < 1) ticks = 1;
+  quanta[sliceClassOf(priority)] = ticks;
+}
+
+int getQuantum(int priority) { return quanta[sliceClassOf(priority)]; }
+
+void addProcess(tProcess *proc) { policyAdd(proc); }
+
+// Like the rest of the scheduler, expects interrupts to be disabled (the
+// syscall gate and the timer interrupt disable them)
 void removeProcess(tProcess *process) {
-  _cli();
-  int procTickets = 0;
-  processList = recRem(processList, process, &procTickets);
-  if (processList == NULL) {
+  policyRemove(process);
+  if (preempt == process) {
+    preempt = NULL;
+    donatedSlice = 0;
+  }
+  if (policyReadyCount() == 0) {
     running = NULL;
   }
-  _sti();
+}
+
+void setPriority(tProcess *process, int priority) {
+  policySetPriority(process, priority);
 }
 
 void killProc(unsigned long int pid) {
-  int r = 0;
-  if (pid == running->pid) r = 1;
-  tProcess *p = getSchedProcess(pid);
-  removeProcess(p);
-  freeProcess(p);
-  if (r == 1) _interrupt();
+  tProcess *p = getProcess(pid);
+  if (p == NULL || p->status == ZOMBIE) return;
+  int r = (p == running);
+  terminate(p, KILLED_STATUS);
+  if (r == 1) {
+    running = NULL;
+    reschedule();
+  }
+}
+
+long int waitChild(long int pid, int *status, int options) {
+  tProcess *parent = running;
+  while (1) {
+    tProcess *child;
+    if (pid == ANY_CHILD) {
+      child = findChild(parent->pid, 1);
+      if (child == NULL && findChild(parent->pid, 0) == NULL) return -1;
+    } else {
+      child = getProcess(pid);
+      if (child == NULL || child->parent != parent->pid) return -1;
+      if (child->status != ZOMBIE) child = NULL;
+    }
+    if (child != NULL) {
+      long int childPid = child->pid;
+      if (status != NULL) *status = child->exitStatus;
+      freeProcess(child);
+      return childPid;
+    }
+    if (options & WNOHANG) return 0;
+    waitOn(&parent->childExit);
+  }
 }
 
-void lottery(uint64_t rsp) {
+void schedule(uint64_t rsp) {
   if (running != NULL && rsp < running->stackTop) {
     // stack overflow
     _exceptionStackOverflowHandler();
   }
-  if (processList == NULL) {
-    return;
+  if (running != NULL) {
+    running->cpuTicks++;
   }
-  if (quantum != 0) {
+  if (quantum > 1 && preempt == NULL) {
     quantum--;
     return;
+  }
+  switchNext();
+}
+
+// Switches from the running process (if any) to the one it is preempted
+// by or else the policy's pick. Interrupted processes keep their interrupt
+// frame on their own stack and go back through it once switched to again,
+// so the interrupt is acknowledged here, before leaving its handler
+static void switchNext() {
+  tProcess *prev = running;
+  tProcess *next;
+  if (policyReadyCount() == 0) return;
+  int slice = 0;
+  if (preempt != NULL) {
+    next = preempt;
+    slice = donatedSlice;
+    preempt = NULL;
+    donatedSlice = 0;
   } else {
-    winner = rand() % tickets;
-    while (runTicket(winner, rsp) != 1) {
-      winner = rand() % tickets;
-    }
-    quantum = QUANTUM;
-    _runProcess(running->rsp);
+    next = policyNext(prev);
   }
+  quantum = slice > 0 ? slice : quanta[policySliceClass(next)];
+  running = next;
+  if (next == prev) return;
+  _signalEOI();
+  _switchTo(prev != NULL ? &prev->rsp : &deadRsp, next->rsp);
 }
 
+// Halts the CPU until the next interrupt. When it is the only ready process
+// the timer is not even ticking
 static void idle(void) {
   _sti();
   _signalEOI();
   while (1) {
+    _cli();
+    if (policyReadyCount() == 1) startTickless();
+    _hlt();
+    _cli();
+    stopTickless();
+    // An interrupt may have woken a process up, hand it the CPU right away
+    if (policyReadyCount() > 1) reschedule();
+    _sti();
   }
 }
 
-static int runTicket(int ticket, uint64_t rsp) {
-  auxList = processList;
-  while (auxList != NULL) {
-    if (inRange(auxList->tickRange, ticket)) {
-      if (running != NULL) running->rsp = rsp;
-      running = auxList->process;
-      return 1;
-    }
-    auxList = auxList->next;
-  }
-  return 0;
+tProcess *getCurrentProcess() { return running; }
+
+void waitOn(tList *waitList) {
+  tProcess *proc = running;
+  listPushBack(waitList, &proc->waitLink);
+  proc->status = BLOCKED;
+  removeProcess(proc);
+  reschedule();
 }
 
-tProcess *getCurrentProcess() { return running; }
+tProcess *wakeOne(tList *waitList) {
+  tLink *link = listFront(waitList);
+  if (link == NULL) return NULL;
+  tProcess *proc = listEntry(link, tProcess, waitLink);
+  wakeProcess(proc);
+  return proc;
+}
 
-static tProcess *getSchedProcess(unsigned long int pid) {
-  _cli();
-  auxList = processList;
-  while (auxList != NULL && auxList->process->pid != pid) {
-    auxList = auxList->next;
+void wakeProcess(tProcess *proc) {
+  listRemove(&proc->waitLink);
+  proc->status = READY;
+  policyWake(proc);
+  policyAdd(proc);
+  if (running != NULL && policyPreempts(proc, running) &&
+      (preempt == NULL || policyPreempts(proc, preempt))) {
+    preempt = proc;
+    donatedSlice = 0;
   }
-  if (auxList == NULL) {
-    _sti();
-    return NULL;
+}
+
+void handOff(tProcess *proc) {
+  if (!handoff) {
+    // leave it to the policy, not even wakeup preemption
+    if (preempt == proc) preempt = NULL;
+    return;
+  }
+  if (running == NULL || proc->status != READY) return;
+  preempt = proc;
+  donatedSlice = quantum;
+}
+
+int setHandoff(int enabled) {
+  int old = handoff;
+  handoff = enabled != 0;
+  return old;
+}
+
+void preemptOnIrq() {
+  if (preempt != NULL) switchNext();
+}
+
+void preemptOnSyscall() {
+  if (preempt != NULL) reschedule();
+}
+
+void wakeAll(tList *waitList) {
+  while (wakeOne(waitList) != NULL) {
   }
-  _sti();
-  return auxList->process;
 }
 
 void initStack(tProcess *proc) {
@@ -220,10 +322,6 @@ void initStack(tProcess *proc) {
                          (uint64_t)run);
 }
 
-static int inRange(tRange *range, int num) {
-  return (num >= range->from) && (num <= range->to);
-}
-
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 //////////////////////////////////////////  ///////
 //////////////////////////////////////////////////////////
@@ -236,28 +334,71 @@ static int inRange(tRange *range, int num) {
 ///////////////////////////////////////////////////////
 ////////////////////////////////////////////////////////////////////////////////////////////////////////////
 
-void printProcList() {
-  auxList = processList;
-  while (auxList != NULL) {
-    putStr(auxList->process->name);
-    auxList = auxList->next;
+// Measures the scheduler operations with the given amount of ready
+// processes on a separate ticket tree, so the running processes are not
+// affected. The range walk the tree replaced is timed on the same tickets
+void schedBenchmark(int processes, int draws, tSchedBench *result) {
+  static const int priorities[] = {HIGHP, MIDP, LOWP};
+  if (processes < 1) processes = 1;
+  if (processes > MAX_SLOTS) processes = MAX_SLOTS;
+  if (draws < 1) draws = 1;
+  tTicketTree *bench = malloc(sizeof(tTicketTree));
+  int *slotTickets = malloc(processes * sizeof(int));
+  if (bench == NULL || slotTickets == NULL) {
+    free(bench);
+    free(slotTickets);
+    return;
+  }
+
+  ticketTreeInit(bench);
+  uint64_t start = _rdtsc();
+  for (int i = 0; i < processes; i++) {
+    slotTickets[i] = priorities[i % 3];
+    ticketTreeAdd(bench, i, slotTickets[i]);
+  }
+  result->addCycles = (_rdtsc() - start) / processes;
+
+  volatile int found = 0;
+  start = _rdtsc();
+  for (int i = 0; i < draws; i++) {
+    found = ticketTreeFind(bench, rand() % ticketTreeTotal(bench));
+  }
+  result->drawCycles = (_rdtsc() - start) / draws;
+
+  start = _rdtsc();
+  for (int i = 0; i < draws; i++) {
+    int ticket = rand() % ticketTreeTotal(bench);
+    int slot = 0;
+    while (ticket >= slotTickets[slot]) {
+      ticket -= slotTickets[slot++];
+    }
+    found = slot;
   }
+  result->walkCycles = (_rdtsc() - start) / draws;
+
+  start = _rdtsc();
+  for (int i = 0; i < processes; i++) {
+    ticketTreeAdd(bench, i, -slotTickets[i]);
+  }
+  result->removeCycles = (_rdtsc() - start) / processes;
+  (void)found;
+
+  free(bench);
+  free(slotTickets);
 }
 
 void pipeTest();
 void sonTest();
 
 void startTest(int (*entryPoint)(int, char **)) {
-  processList = NULL;
-  tickets = 0;
-  quantum = QUANTUM;
-  running = NULL;
+  initializeScheduler();
   initializeMM();
   initializeProcesses();
   initializePipes();
-  mutexQueue = NULL;
-  semQueue = NULL;
-  readSem = semCreate(0);
+  initializeFutexes();
+  initializeTimer();
+  initializeRegistry();
+  initializeTty();
   ////////////////////////
   tProcess *sys_idle = newProcess("sysIdle", (entryFnc)idle, 0, NULL, IDLE);
   initStack(sys_idle);
@@ -269,7 +410,7 @@ void startTest(int (*entryPoint)(int, char **)) {
   addProcess(pipeTestProc);
   ////////////////////////
   running = pipeTestProc;
-  _runProcess(running->rsp);
+  _switchTo(&deadRsp, pipeTestProc->rsp);
 }
 
 void pipeTest() {
@@ -0,0 +1,350 @@
+//       SEGREGATED FREE LIST MEMORY MANAGER
+
+// *    Managable memory is a single region split into blocks. Every block
+// *starts with a header holding its size and two flags (free, previous block
+// *free); free blocks also keep their size in a footer (boundary tag) so a
+// *block can find its left neighbour in constant time.
+// *    Free blocks are kept in segregated lists indexed by a two level size
+// *class (power of two range, then linear subdivision of that range). Two
+// *bitmaps record which classes are non-empty, so finding a fitting block and
+// *releasing one are O(1) instead of a walk over every partition.
+
+#include "include/memoryManager.h"
+#include "include/videoDriver.h"
+
+#ifdef SEGREGATED_MM
+
+#define ALIGNMENT sizeof(size_t)
+#define HEADER_SIZE sizeof(size_t)
+#define FREE_BIT ((size_t)1)
+#define PREV_FREE_BIT ((size_t)2)
+#define FLAGS_MASK (FREE_BIT | PREV_FREE_BIT)
+
+// Second level: each power of two range is split into 2^SL_LOG2 classes
+#define SL_LOG2 2
+#define SL_COUNT (1 << SL_LOG2)
+// First level: one class per power of two, starting at MIN_BLOCK_SIZE
+#define FL_SHIFT 5
+#define FL_COUNT 32
+
+typedef struct blockHeader {
+  size_t size;  // whole block size (header included) | flags
+  // Only meaningful while the block is free
+  struct blockHeader *nextFree;
+  struct blockHeader *prevFree;
+} blockHeader;
+
+#define MIN_BLOCK_SIZE (sizeof(blockHeader) + sizeof(size_t))
+
+static uint8_t *const startAddress = (uint8_t *)0x1000000;
+static uint8_t *baseAddress;
+static uint8_t *endAddress;
+
+static uint32_t flBitmap;
+static uint32_t slBitmap[FL_COUNT];
+static blockHeader *freeLists[FL_COUNT][SL_COUNT];
+
+static size_t blockSize(blockHeader *block);
+static blockHeader *nextBlock(blockHeader *block);
+static blockHeader *prevBlock(blockHeader *block);
+static void setFree(blockHeader *block, size_t size);
+static void setUsed(blockHeader *block);
+static void mapping(size_t size, int *fl, int *sl);
+static void insertBlock(blockHeader *block);
+static void removeBlock(blockHeader *block);
+static blockHeader *findFreeBlock(size_t size);
+static void splitBlock(blockHeader *block, size_t size);
+static blockHeader *mergeFree(blockHeader *block);
+static size_t adjustSize(size_t space);
+static blockHeader *getBlock(void *address);
+
+void *malloc(size_t space) {
+  if (baseAddress == NULL) {
+    initializeMM();
+  }
+  if (space == 0 || space > MEM_SIZE) {
+    return NULL;
+  }
+  size_t size = adjustSize(space);
+  blockHeader *block = findFreeBlock(size);
+  if (block == NULL) {
+    return NULL;
+  }
+  removeBlock(block);
+  splitBlock(block, size);
+  setUsed(block);
+  return (uint8_t *)block + HEADER_SIZE;
+}
+
+void *realloc(void *memoryAddress, size_t space) {
+  if (memoryAddress == NULL) {
+    return malloc(space);
+  }
+  blockHeader *block = getBlock(memoryAddress);
+  if (block == NULL || space > MEM_SIZE) {
+    return NULL;
+  }
+  size_t size = adjustSize(space);
+  size_t oldSize = blockSize(block);
+
+  // Grow in place when the right neighbour is free and big enough
+  blockHeader *next = nextBlock(block);
+  if (size > oldSize && (next->size & FREE_BIT) &&
+      oldSize + blockSize(next) >= size) {
+    removeBlock(next);
+    block->size = (oldSize + blockSize(next)) | (block->size & FLAGS_MASK);
+    nextBlock(block)->size &= ~PREV_FREE_BIT;
+    oldSize = blockSize(block);
+  }
+  if (size <= oldSize) {
+    splitBlock(block, size);
+    return memoryAddress;
+  }
+
+  void *retAddress = malloc(space);
+  if (retAddress == NULL) {
+    return NULL;
+  }
+  memcpy(retAddress, memoryAddress, oldSize - HEADER_SIZE);
+  free(memoryAddress);
+  return retAddress;
+}
+
+void *calloc(size_t space) {
+  void *retAddress = malloc(space);
+  if (retAddress != NULL) {
+    memset(retAddress, 0, space);
+  }
+  return retAddress;
+}
+
+void free(void *memoryAddress) {
+  blockHeader *block = getBlock(memoryAddress);
+  if (block == NULL || (block->size & FREE_BIT)) {
+    return;
+  }
+  block = mergeFree(block);
+  insertBlock(block);
+}
+
+// ****************     a      ********************
+// ****************     u      ********************
+// ****************     x      ********************
+
+void initializeMM() {
+  baseAddress = startAddress;
+  endAddress = baseAddress + MEM_SIZE - HEADER_SIZE;
+  flBitmap = 0;
+  for (int i = 0; i < FL_COUNT; i++) {
+    slBitmap[i] = 0;
+    for (int j = 0; j < SL_COUNT; j++) {
+      freeLists[i][j] = NULL;
+    }
+  }
+
+  // Sentinel block closing the region: always used, never merged
+  blockHeader *sentinel = (blockHeader *)endAddress;
+  sentinel->size = 0;
+
+  // No block precedes it, so no previous free flag may survive
+  blockHeader *first = (blockHeader *)baseAddress;
+  first->size = 0;
+  setFree(first, endAddress - baseAddress);
+  insertBlock(first);
+}
+
+// Walks the blocks from the start, so an address inside one matches none
+size_t allocatedSize(void *memoryAddress) {
+  blockHeader *target = getBlock(memoryAddress);
+  if (target == NULL) {
+    return 0;
+  }
+  blockHeader *block = (blockHeader *)baseAddress;
+  while (block < target) {
+    block = nextBlock(block);
+  }
+  if (block != target || (block->size & FREE_BIT)) {
+    return 0;
+  }
+  return blockSize(block) - HEADER_SIZE;
+}
+
+static size_t blockSize(blockHeader *block) { return block->size & ~FLAGS_MASK; }
+
+static blockHeader *nextBlock(blockHeader *block) {
+  return (blockHeader *)((uint8_t *)block + blockSize(block));
+}
+
+// Only valid when PREV_FREE_BIT is set: reads the left neighbour's footer
+static blockHeader *prevBlock(blockHeader *block) {
+  size_t prevSize = *((size_t *)block - 1);
+  return (blockHeader *)((uint8_t *)block - prevSize);
+}
+
+// Marks the block as free with the given size and writes its boundary tag
+static void setFree(blockHeader *block, size_t size) {
+  block->size = size | FREE_BIT | (block->size & PREV_FREE_BIT);
+  *(size_t *)((uint8_t *)block + size - sizeof(size_t)) = size;
+  nextBlock(block)->size |= PREV_FREE_BIT;
+}
+
+static void setUsed(blockHeader *block) {
+  block->size &= ~FREE_BIT;
+  nextBlock(block)->size &= ~PREV_FREE_BIT;
+}
+
+// Size class of a block: fl is the power of two range, sl the subdivision
+static void mapping(size_t size, int *fl, int *sl) {
+  int msb = 63 - __builtin_clzl(size);
+  *fl = msb - FL_SHIFT;
+  *sl = (int)(size >> (msb - SL_LOG2)) & (SL_COUNT - 1);
+}
+
+static void insertBlock(blockHeader *block) {
+  int fl, sl;
+  mapping(blockSize(block), &fl, &sl);
+  block->prevFree = NULL;
+  block->nextFree = freeLists[fl][sl];
+  if (block->nextFree != NULL) {
+    block->nextFree->prevFree = block;
+  }
+  freeLists[fl][sl] = block;
+  flBitmap |= (uint32_t)1 << fl;
+  slBitmap[fl] |= (uint32_t)1 << sl;
+}
+
+static void removeBlock(blockHeader *block) {
+  int fl, sl;
+  mapping(blockSize(block), &fl, &sl);
+  if (block->prevFree != NULL) {
+    block->prevFree->nextFree = block->nextFree;
+  } else {
+    freeLists[fl][sl] = block->nextFree;
+  }
+  if (block->nextFree != NULL) {
+    block->nextFree->prevFree = block->prevFree;
+  }
+  if (freeLists[fl][sl] == NULL) {
+    slBitmap[fl] &= ~((uint32_t)1 << sl);
+    if (slBitmap[fl] == 0) {
+      flBitmap &= ~((uint32_t)1 << fl);
+    }
+  }
+}
+
+// Returns the head of the first non-empty class whose every block is at
+// least size bytes long. When there is none, the blocks sharing size's own
+// class are checked one by one (only happens when memory is nearly exhausted)
+static blockHeader *findFreeBlock(size_t size) {
+  int fl, sl;
+  // Round up to the next class boundary so any block in the class fits
+  int msb = 63 - __builtin_clzl(size);
+  mapping(size + ((size_t)1 << (msb - SL_LOG2)) - 1, &fl, &sl);
+
+  uint32_t slMap = (fl < FL_COUNT) ? slBitmap[fl] & (~(uint32_t)0 << sl) : 0;
+  if (slMap == 0) {
+    uint32_t flMap = (fl + 1 < FL_COUNT) ? flBitmap & (~(uint32_t)0 << (fl + 1))
+                                         : 0;
+    if (flMap == 0) {
+      mapping(size, &fl, &sl);
+      blockHeader *block = (fl < FL_COUNT) ? freeLists[fl][sl] : NULL;
+      while (block != NULL && blockSize(block) < size) {
+        block = block->nextFree;
+      }
+      return block;
+    }
+    fl = __builtin_ctz(flMap);
+    slMap = slBitmap[fl];
+  }
+  sl = __builtin_ctz(slMap);
+  return freeLists[fl][sl];
+}
+
+// Trims a block to size, releasing the tail as a new free block when it is
+// big enough to stand on its own
+static void splitBlock(blockHeader *block, size_t size) {
+  size_t total = blockSize(block);
+  if (total - size < MIN_BLOCK_SIZE) {
+    return;
+  }
+  block->size = size | (block->size & FLAGS_MASK);
+  blockHeader *rest = nextBlock(block);
+  rest->size = 0;
+  setFree(rest, total - size);
+  insertBlock(mergeFree(rest));
+}
+
+// Marks the block as free and joins it with its free neighbours. The merged
+// block is returned out of any list
+static blockHeader *mergeFree(blockHeader *block) {
+  size_t size = blockSize(block);
+  blockHeader *next = nextBlock(block);
+  if (next->size & FREE_BIT) {
+    removeBlock(next);
+    size += blockSize(next);
+  }
+  if (block->size & PREV_FREE_BIT) {
+    blockHeader *prev = prevBlock(block);
+    removeBlock(prev);
+    size += blockSize(prev);
+    block = prev;
+  }
+  setFree(block, size);
+  return block;
+}
+
+static size_t adjustSize(size_t space) {
+  size_t size = (space + HEADER_SIZE + ALIGNMENT - 1) & ~(ALIGNMENT - 1);
+  return size < MIN_BLOCK_SIZE ? MIN_BLOCK_SIZE : size;
+}
+
+// given an address returns its block header if it is a valid heap address
+static blockHeader *getBlock(void *address) {
+  if (baseAddress == NULL || address == NULL ||
+      (uint8_t *)address < baseAddress + HEADER_SIZE ||
+      (uint8_t *)address >= endAddress) {
+    return NULL;
+  }
+  return (blockHeader *)((uint8_t *)address - HEADER_SIZE);
+}
+
+// used for testing solo usar si el content es un string
+void printNode(uint8_t *address) {
+  blockHeader *block = getBlock(address);
+  if (block == NULL) {
+    putStr("Invalid node: this node does not exist or has been freed \n");
+    putStr("----");
+    newLine();
+    return;
+  }
+  putStr("\n----\n");
+  // A free block keeps its list links at the start of its content
+  if (!(block->size & FREE_BIT)) {
+    putStr("content: ");
+    putStr((char *)address);
+    newLine();
+  }
+
+  putStr("address ");
+  char buff[10];
+  putStr(decToStr((size_t)address, buff));
+  newLine();
+
+  putStr("size: ");
+  char buffer[10];
+  putStr(decToStr((size_t)(blockSize(block) - HEADER_SIZE), buffer));
+  newLine();
+
+  putStr("available: ");
+  if (block->size & FREE_BIT) {
+    putStr("YES");
+  } else {
+    putStr("NO");
+  }
+  newLine();
+
+  putStr("----");
+  newLine();
+}
+
+#endif
@@ -1,55 +1,96 @@
 #include "include/semaphore.h"
-#include "include/lib.h"
-#include "include/memoryManager.h"
 #include "include/scheduler.h"
+#include "include/slab.h"
 
-queue_t semQueue;
-void _interrupt();
+static slabCache_t semCache;
+
+static void grantWaiters(sem_t sem);
 
 sem_t semCreate(int startValue) {
-  sem_t sem = malloc(sizeof(tSemaphore));
+  if (semCache == NULL) {
+    semCache = slabCacheCreate("semaphore", sizeof(tSemaphore));
+  }
+  sem_t sem = slabAlloc(semCache);
   if (sem == NULL) return NULL;
   sem->value = startValue;
-  sem->lockedQueue = queueCreate(sizeof(tProcess*));
-  sem->mutex = mutexCreate();
+  listInit(&sem->lockedList);
   return sem;
 }
 
 int semGetValue(sem_t sem) { return sem->value; }
 
 void semDelete(sem_t sem) {
-  mutexDelete(sem->mutex);
-  queueFree(sem->lockedQueue);
-  free(sem);
+  slabFree(semCache, sem);
 }
 
-void semWait(sem_t sem) {
+void semWait(sem_t sem) { semWaitN(sem, 1); }
 
-  if (sem == NULL) {
+void semPost(sem_t sem) { semPostN(sem, 1); }
+
+// Semaphores are used from syscalls and interrupt handlers, which run with
+// interrupts disabled, so no lock is needed around the value
+void semWaitN(sem_t sem, int count) {
+  if (sem == NULL || count <= 0) return;
+  // Waiters are served in order, a big request is not overtaken
+  if (listIsEmpty(&sem->lockedList) && sem->value >= count) {
+    sem->value -= count;
     return;
   }
-  mutexLock(sem->mutex);
   tProcess* running = getCurrentProcess();
-  if (sem->value == 0) {
-    queueOffer(sem->lockedQueue, &running);
-    mutexUnlock(sem->mutex);
-    removeProcess(running);
-    _interrupt();
-  } else {
-    sem->value--;
-    mutexUnlock(sem->mutex);
-  }
+  running->semUnits = count;
+  running->semBlockedOn = sem;
+  waitOn(&sem->lockedList);
+  // the poster already took the units for this process
 }
 
-void semPost(sem_t sem) {
+void semPostN(sem_t sem, int count) {
+  if (sem == NULL || count <= 0) return;
+  sem->value += count;
+  grantWaiters(sem);
+}
+
+void semAbandon(tProcess* process) {
+  sem_t sem = process->semBlockedOn;
   if (sem == NULL) return;
-  mutexLock(sem->mutex);
-  if (queueSize(sem->lockedQueue) != 0) {
-    tProcess* proc;
-    queuePoll(sem->lockedQueue, &proc);
-    addProcess(proc);
-  } else {
-    sem->value++;
+  listRemove(&process->waitLink);
+  process->semBlockedOn = NULL;
+  grantWaiters(sem);
+}
+
+void condWait(sem_t cond, mutex_t mutex) {
+  if (cond == NULL) return;
+  tProcess* running = getCurrentProcess();
+  running->semUnits = 0;
+  mutexUnlock(mutex);
+  waitOn(&cond->lockedList);
+  mutexLock(mutex);
+}
+
+void condSignal(sem_t cond) {
+  if (cond == NULL) return;
+  tProcess* waiter = wakeOne(&cond->lockedList);
+  if (waiter != NULL) waiter->semBlockedOn = NULL;
+}
+
+void condBroadcast(sem_t cond) {
+  if (cond == NULL) return;
+  while (!listIsEmpty(&cond->lockedList)) {
+    condSignal(cond);
+  }
+}
+
+// Wakes waiters in order while the value covers what the first one asks
+// for. The first one woken gets the poster's CPU
+static void grantWaiters(sem_t sem) {
+  tProcess* first = NULL;
+  tLink* link;
+  while ((link = listFront(&sem->lockedList)) != NULL) {
+    tProcess* waiter = listEntry(link, tProcess, waitLink);
+    if (waiter->semUnits > sem->value) break;
+    sem->value -= waiter->semUnits;
+    waiter->semBlockedOn = NULL;
+    wakeProcess(waiter);
+    if (first == NULL) first = waiter;
   }
-  mutexUnlock(sem->mutex);
+  if (first != NULL) handOff(first);
 }
@@ -0,0 +1,121 @@
+#include "include/slab.h"
+#include <stdint.h>
+#include "include/lib.h"
+#include "include/memoryManager.h"
+
+#define SLAB_SIZE 4096
+#define MIN_OBJECTS_PER_SLAB 8
+
+typedef struct tSlab {
+  struct tSlab* next;
+} tSlab;
+
+typedef struct tFreeObject {
+  struct tFreeObject* next;
+} tFreeObject;
+
+typedef struct tSlabCache {
+  char name[MAX_CACHE_NAME];
+  size_t objectSize;
+  size_t slabSize;
+  int objectsPerSlab;
+  tFreeObject* freeList;
+  tSlab* slabs;
+  int slabCount;
+  int inUse;
+  unsigned long allocs;
+  unsigned long frees;
+  struct tSlabCache* next;
+} tSlabCache;
+
+static tSlabCache* caches;
+
+static int grow(slabCache_t cache);
+
+slabCache_t slabCacheCreate(char* name, size_t objectSize) {
+  slabCache_t cache = malloc(sizeof(tSlabCache));
+  if (cache == NULL) return NULL;
+  int len = strlen(name);
+  if (len >= MAX_CACHE_NAME) len = MAX_CACHE_NAME - 1;
+  memcpy(cache->name, name, len);
+  cache->name[len] = 0;
+
+  if (objectSize < sizeof(tFreeObject)) objectSize = sizeof(tFreeObject);
+  cache->objectSize = (objectSize + sizeof(void*) - 1) & ~(sizeof(void*) - 1);
+  cache->slabSize = SLAB_SIZE;
+  if (cache->slabSize - sizeof(tSlab) <
+      cache->objectSize * MIN_OBJECTS_PER_SLAB) {
+    cache->slabSize = sizeof(tSlab) + cache->objectSize * MIN_OBJECTS_PER_SLAB;
+  }
+  cache->objectsPerSlab = (cache->slabSize - sizeof(tSlab)) / cache->objectSize;
+  cache->freeList = NULL;
+  cache->slabs = NULL;
+  cache->slabCount = 0;
+  cache->inUse = 0;
+  cache->allocs = 0;
+  cache->frees = 0;
+
+  cache->next = caches;
+  caches = cache;
+  return cache;
+}
+
+void* slabAlloc(slabCache_t cache) {
+  if (cache == NULL) return NULL;
+  if (cache->freeList == NULL && !grow(cache)) return NULL;
+  tFreeObject* object = cache->freeList;
+  cache->freeList = object->next;
+  cache->inUse++;
+  cache->allocs++;
+  return object;
+}
+
+void slabFree(slabCache_t cache, void* object) {
+  if (cache == NULL || object == NULL) return;
+  tFreeObject* freeObject = object;
+  freeObject->next = cache->freeList;
+  cache->freeList = freeObject;
+  cache->inUse--;
+  cache->frees++;
+}
+
+void slabGetStats(slabCache_t cache, tSlabStats* stats) {
+  stats->name = cache->name;
+  stats->objectSize = cache->objectSize;
+  stats->slabs = cache->slabCount;
+  stats->objects = cache->slabCount * cache->objectsPerSlab;
+  stats->inUse = cache->inUse;
+  stats->allocs = cache->allocs;
+  stats->frees = cache->frees;
+}
+
+void printSlabs() {
+  tSlabStats stats;
+  printf("Cache          Size   Slabs   Objects   In use   Allocs   Frees\n");
+  for (tSlabCache* cache = caches; cache != NULL; cache = cache->next) {
+    slabGetStats(cache, &stats);
+    printf("%s", stats.name);
+    for (int i = strlen(stats.name); i < 15; i++) printf(" ");
+    printf("%d     %d       %d        %d       %d       %d\n",
+           (int)stats.objectSize, stats.slabs, stats.objects, stats.inUse,
+           (int)stats.allocs, (int)stats.frees);
+  }
+}
+
+// Takes a new slab from the heap and threads its objects into the free list
+static int grow(slabCache_t cache) {
+  tSlab* slab = malloc(cache->slabSize);
+  if (slab == NULL) return 0;
+  slab->next = cache->slabs;
+  cache->slabs = slab;
+  cache->slabCount++;
+
+  uint8_t* object = (uint8_t*)(slab + 1);
+  for (int i = 0; i < cache->objectsPerSlab; i++) {
+    tFreeObject* freeObject = (tFreeObject*)object;
+    freeObject->next = cache->freeList;
+    cache->freeList = freeObject;
+    object += cache->objectSize;
+  }
+  return 1;
+}
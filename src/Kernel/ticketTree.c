@@ -0,0 +1,30 @@
+#include "include/ticketTree.h"
+
+void ticketTreeInit(tTicketTree* tickets) {
+  tickets->total = 0;
+  for (int i = 0; i <= MAX_SLOTS; i++) {
+    tickets->tree[i] = 0;
+  }
+}
+
+void ticketTreeAdd(tTicketTree* tickets, int slot, int delta) {
+  tickets->total += delta;
+  for (int i = slot + 1; i <= MAX_SLOTS; i += i & (-i)) {
+    tickets->tree[i] += delta;
+  }
+}
+
+int ticketTreeFind(tTicketTree* tickets, int ticket) {
+  // Descends the implicit tree, skipping every block of slots whose tickets
+  // all come before the one searched
+  int pos = 0;
+  for (int step = MAX_SLOTS; step > 0; step >>= 1) {
+    if (pos + step <= MAX_SLOTS && tickets->tree[pos + step] <= ticket) {
+      pos += step;
+      ticket -= tickets->tree[pos];
+    }
+  }
+  return pos;
+}
+
+int ticketTreeTotal(tTicketTree* tickets) { return tickets->total; }
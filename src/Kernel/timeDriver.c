@@ -2,18 +2,101 @@
 #include "include/timeDriverASM.h"
 #include "include/videoDriver.h"
 #include "include/lib.h"
+#include "include/scheduler.h"
+#include "include/timerWheel.h"
 
-void _sti();
+#define PIT_FREQUENCY 1193182
+#define PIT_MAX_DIVISOR 65536  // a divisor of 0 means 65536
+// A one shot count that ran out wraps around to 0xFFFF, the margin tells
+// it apart from one still running
+#define PIT_MAX_COUNT 0xF000
 
 static unsigned long ticks = 0;
+static unsigned int divisor = PIT_MAX_DIVISOR;
+static unsigned long skipped = 0;  // ticks the one shot timer covers
 
-void timeHandler() { ticks++; }
+static void tick();
+static void endTickless(unsigned long elapsed);
+
+void timeHandler() {
+  if (skipped != 0) {
+    endTickless(skipped);
+  } else {
+    tick();
+  }
+}
+
+static void tick() {
+  ticks++;
+  tList expired;
+  listInit(&expired);
+  timerWheelAdvance(&expired);
+  wakeAll(&expired);
+}
+
+void startTickless() {
+  unsigned long idleTicks = timerWheelIdleTicks();
+  unsigned long maxTicks = PIT_MAX_COUNT / divisor;
+  if (idleTicks > maxTicks) idleTicks = maxTicks;
+  if (idleTicks < 2) return;
+  skipped = idleTicks;
+  _setPITOneShot((uint16_t)(skipped * divisor));
+}
+
+void stopTickless() {
+  if (skipped == 0) return;
+  unsigned long count = skipped * divisor;
+  unsigned long left = _readPIT();
+  // The last tick is left to the timer interrupt, which may already be
+  // pending if the count ran out
+  unsigned long elapsed = left > count ? skipped : (count - left) / divisor;
+  if (elapsed > skipped - 1) elapsed = skipped - 1;
+  endTickless(elapsed);
+}
+
+// Goes back to periodic interrupts, catching up with the elapsed ticks
+static void endTickless(unsigned long elapsed) {
+  skipped = 0;
+  _setPIT((uint16_t)divisor);
+  while (elapsed-- > 0) {
+    tick();
+  }
+}
+
+void initializeTimer() {
+  timerWheelInit(ticks);
+}
+
+void sleep(unsigned long n) {
+  tProcess* process = getCurrentProcess();
+  unsigned long wakeTick = ticks + n;
+  // Sleeps longer than the wheel span are done in several passes
+  while (ticks < wakeTick) {
+    process->wakeTick = wakeTick;
+    waitOn(timerWheelSlot(wakeTick));
+  }
+}
 
 int ticksElapsed() { return ticks; }
+
+void setTimerFrequency(unsigned int hz) {
+  skipped = 0;
+  if (hz <= PIT_FREQUENCY / PIT_MAX_DIVISOR) {
+    divisor = PIT_MAX_DIVISOR;
+  } else if (hz >= PIT_FREQUENCY / 2) {
+    divisor = 2;  // mode 2 does not allow a divisor of 1
+  } else {
+    divisor = PIT_FREQUENCY / hz;
+  }
+  _setPIT((uint16_t)divisor);
+}
+
+unsigned int getTimerFrequency() { return PIT_FREQUENCY / divisor; }
+
 void wait(int n) {
-  _sti();
-  unsigned long t = ticks + n;
-  while (ticks < t) {}
+  if (n <= 0) return;
+  // n is given in ticks of the PIT default rate (18.2 Hz)
+  sleep(((unsigned long)n * PIT_MAX_DIVISOR + divisor - 1) / divisor);
 }
 
 unsigned int getHour() {
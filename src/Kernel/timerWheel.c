@@ -0,0 +1,67 @@
+#include "include/timerWheel.h"
+#include "include/process.h"
+
+#define WHEEL_MASK (WHEEL_SLOTS - 1)
+
+static tList wheel[WHEEL_LEVELS][WHEEL_SLOTS];
+static unsigned long next;  // tick whose level 0 slot runs on the next advance
+
+static void cascade(int level, int index);
+
+void timerWheelInit(unsigned long now) {
+  next = now + 1;
+  for (int i = 0; i < WHEEL_LEVELS; i++) {
+    for (int j = 0; j < WHEEL_SLOTS; j++) {
+      listInit(&wheel[i][j]);
+    }
+  }
+}
+
+tList* timerWheelSlot(unsigned long wakeTick) {
+  // Ticks already run wake up on the next one
+  if (wakeTick < next) wakeTick = next;
+  unsigned long delta = wakeTick - next;
+  if (delta >= WHEEL_SPAN) wakeTick = next + WHEEL_SPAN - 1;
+  int level = 0;
+  while (level < WHEEL_LEVELS - 1 &&
+         delta >= (unsigned long)1 << (WHEEL_BITS * (level + 1))) {
+    level++;
+  }
+  return &wheel[level][(wakeTick >> (WHEEL_BITS * level)) & WHEEL_MASK];
+}
+
+void timerWheelAdvance(tList* expired) {
+  // Each time a level wraps around, the next slot of the level above is due
+  // to be spread over the levels below
+  if ((next & WHEEL_MASK) == 0) {
+    for (int level = 1; level < WHEEL_LEVELS; level++) {
+      int index = (next >> (WHEEL_BITS * level)) & WHEEL_MASK;
+      cascade(level, index);
+      if (index != 0) break;
+    }
+  }
+  listMoveAll(&wheel[0][next & WHEEL_MASK], expired);
+  next++;
+}
+
+unsigned long timerWheelIdleTicks() {
+  // A cascade may bring sleepers due sooner, so it is never skipped over
+  if ((next & WHEEL_MASK) == 0) return 1;
+  unsigned long tick = next;
+  while (listIsEmpty(&wheel[0][tick & WHEEL_MASK]) &&
+         ((tick + 1) & WHEEL_MASK) != 0) {
+    tick++;
+  }
+  return tick - next + 1;
+}
+
+static void cascade(int level, int index) {
+  tList pending;
+  listInit(&pending);
+  listMoveAll(&wheel[level][index], &pending);
+  tLink* link;
+  while ((link = listPopFront(&pending)) != NULL) {
+    tProcess* process = listEntry(link, tProcess, waitLink);
+    listPushBack(timerWheelSlot(process->wakeTick), link);
+  }
+}
@@ -0,0 +1,143 @@
+#include "include/tty.h"
+#include "include/lib.h"
+#include "include/list.h"
+#include "include/ring.h"
+#include "include/scheduler.h"
+#include "include/videoDriver.h"
+
+#define TTY_BUFFER 512  // power of two, positions are masked
+#define MAX_LINE 256
+
+static Color WHITE = {255, 255, 255};
+
+// Readable input, filled by the keyboard interrupt and drained by readers.
+// In canonical mode only finished lines get here
+static char inputBuffer[TTY_BUFFER];
+static tRing input;
+static int lines;  // newlines in input, both sides run with interrupts off
+
+// Line being edited in canonical mode
+static char line[MAX_LINE];
+static int lineLength;
+
+static int mode;
+static tList readers;
+
+static uint64_t wakeCycles;  // when the last key woke the readers up
+static tTtyLatency latency;
+
+static void wakeReaders();
+static void pushInput(char c);
+static void flushLine();
+static void echo(char c);
+
+void initializeTty() {
+  ringInit(&input, inputBuffer, TTY_BUFFER);
+  lines = 0;
+  lineLength = 0;
+  mode = TTY_DEFAULT;
+  listInit(&readers);
+  latency.samples = latency.totalCycles = latency.maxCycles = 0;
+}
+
+void ttyInput(char c) {
+  if (c == 0) return;
+  if (!(mode & TTY_CANONICAL)) {
+    if (ringSpace(&input) == 0) return;
+    pushInput(c);
+    echo(c);
+    wakeReaders();
+    return;
+  }
+  if (c == '\b') {
+    if (lineLength > 0) {
+      lineLength--;
+      echo(c);
+    }
+    return;
+  }
+  // the newline always fits, so a full line can still be finished
+  if (c != '\n' && (c < 32 || c > 126 || lineLength == MAX_LINE - 1)) return;
+  line[lineLength++] = c;
+  echo(c);
+  if (c == '\n') {
+    flushLine();
+    wakeReaders();
+  }
+}
+
+// Interrupts are disabled during the syscall, so no key is added between
+// the check and going to sleep
+int ttyRead(char* buffer, int size) {
+  if (size <= 0) return 0;
+  int waited = 0;
+  while ((mode & TTY_CANONICAL) ? lines == 0 : ringCount(&input) == 0) {
+    if (mode & TTY_NONBLOCK) return 0;
+    waitOn(&readers);
+    waited = 1;
+  }
+  if (waited) {
+    uint64_t cycles = _rdtsc() - wakeCycles;
+    latency.samples++;
+    latency.totalCycles += cycles;
+    if (cycles > latency.maxCycles) latency.maxCycles = cycles;
+  }
+  int bytes = 0;
+  if (mode & TTY_CANONICAL) {
+    while (bytes < size && ringPop(&input, &buffer[bytes])) {
+      if (buffer[bytes++] == '\n') {
+        lines--;
+        break;
+      }
+    }
+    return bytes;
+  }
+  bytes = ringRead(&input, buffer, size);
+  for (int i = 0; i < bytes; i++) {
+    if (buffer[i] == '\n') lines--;
+  }
+  return bytes;
+}
+
+int ttySetMode(int newMode) {
+  int old = mode;
+  mode = newMode;
+  // the half typed line becomes readable right away. Interrupts are off, so
+  // the keyboard is not pushing meanwhile
+  if ((old & TTY_CANONICAL) && !(newMode & TTY_CANONICAL)) {
+    flushLine();
+    wakeReaders();
+  }
+  return old;
+}
+
+void ttyLatency(tTtyLatency* result) {
+  *result = latency;
+  latency.samples = latency.totalCycles = latency.maxCycles = 0;
+}
+
+static void wakeReaders() {
+  if (listIsEmpty(&readers)) return;
+  wakeCycles = _rdtsc();
+  wakeAll(&readers);
+}
+
+static void pushInput(char c) {
+  ringPush(&input, c);
+  if (c == '\n') lines++;
+}
+
+// Moves the edited line to the readable input. A line that does not fit is
+// dropped whole, so every readable line keeps its newline
+static void flushLine() {
+  if (lineLength <= ringSpace(&input)) {
+    for (int i = 0; i < lineLength; i++) {
+      pushInput(line[i]);
+    }
+  }
+  lineLength = 0;
+}
+
+static void echo(char c) {
+  if (mode & TTY_ECHO) printChar(c, WHITE);
+}
@@ -0,0 +1,44 @@
+; Atomic operations on 32 bit words shared between processes
+
+GLOBAL _xchg
+GLOBAL _cmpxchg
+GLOBAL _atomicAdd
+
+section .text
+
+; int _xchg(int* address, int value): stores value and returns the old one
+_xchg:
+	push rbp
+	mov rbp, rsp
+
+	mov eax, esi
+	xchg eax, [rdi]
+
+	mov rsp, rbp
+	pop rbp
+	ret
+
+; int _cmpxchg(int* address, int expected, int value): stores value only if
+; the word holds expected, returns what the word held
+_cmpxchg:
+	push rbp
+	mov rbp, rsp
+
+	mov eax, esi
+	lock cmpxchg [rdi], edx
+
+	mov rsp, rbp
+	pop rbp
+	ret
+
+; int _atomicAdd(int* address, int delta): adds delta, returns the old value
+_atomicAdd:
+	push rbp
+	mov rbp, rsp
+
+	mov eax, esi
+	lock xadd [rdi], eax
+
+	mov rsp, rbp
+	pop rbp
+	ret
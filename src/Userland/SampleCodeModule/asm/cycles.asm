@@ -0,0 +1,10 @@
+GLOBAL _rdtsc
+
+section .text
+
+; uint64_t _rdtsc(): cycles since the processor was reset
+_rdtsc:
+	rdtsc
+	shl rdx, 32
+	or rax, rdx
+	ret
@@ -0,0 +1,76 @@
+#include "include/futexModule.h"
+#include <stdint.h>
+#include "include/SYSCall.h"
+
+int _xchg(int* address, int value);
+int _cmpxchg(int* address, int expected, int value);
+int _atomicAdd(int* address, int delta);
+
+#define UNLOCKED 0
+#define LOCKED 1
+#define CONTENDED 2
+
+int futexWait(int* address, int expected) {
+  return systemCall((uint64_t)FUTEXWAIT, (uint64_t)address, (uint64_t)expected,
+                    0, 0, 0);
+}
+
+int futexWake(int* address, int count) {
+  return systemCall((uint64_t)FUTEXWAKE, (uint64_t)address, (uint64_t)count, 0,
+                    0, 0);
+}
+
+void fmutexInit(fmutex_t* mutex) { *mutex = UNLOCKED; }
+
+void fmutexLock(fmutex_t* mutex) {
+  int state = _cmpxchg(mutex, UNLOCKED, LOCKED);
+  if (state == UNLOCKED) return;
+  // Mark it contended so the owner knows it has to wake someone
+  if (state != CONTENDED) state = _xchg(mutex, CONTENDED);
+  while (state != UNLOCKED) {
+    futexWait(mutex, CONTENDED);
+    state = _xchg(mutex, CONTENDED);
+  }
+}
+
+void fmutexUnlock(fmutex_t* mutex) {
+  if (_xchg(mutex, UNLOCKED) == CONTENDED) futexWake(mutex, 1);
+}
+
+void fsemInit(fsem_t* sem, int value) {
+  sem->value = value;
+  sem->waiters = 0;
+  sem->batchWaiters = 0;
+}
+
+void fsemWait(fsem_t* sem) { fsemWaitN(sem, 1); }
+
+void fsemPost(fsem_t* sem) { fsemPostN(sem, 1); }
+
+void fsemWaitN(fsem_t* sem, int count) {
+  while (1) {
+    int value = sem->value;
+    if (value >= count) {
+      if (_cmpxchg(&sem->value, value, value - count) == value) return;
+      continue;
+    }
+    // Announced before sleeping, so a post either sees the waiter or
+    // changes the value before the kernel checks it
+    if (count > 1) _atomicAdd(&sem->batchWaiters, 1);
+    _atomicAdd(&sem->waiters, 1);
+    futexWait(&sem->value, value);
+    _atomicAdd(&sem->waiters, -1);
+    if (count > 1) _atomicAdd(&sem->batchWaiters, -1);
+  }
+}
+
+// count units satisfy at most count waiters that take one unit each. When
+// some waiter wants more, any of them may be the one that now fits, so all
+// of them are woken
+void fsemPostN(fsem_t* sem, int count) {
+  _atomicAdd(&sem->value, count);
+  int waiters = sem->waiters;
+  if (waiters == 0) return;
+  if (sem->batchWaiters == 0 && count < waiters) waiters = count;
+  futexWake(&sem->value, waiters);
+}
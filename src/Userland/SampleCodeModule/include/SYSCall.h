@@ -39,7 +39,31 @@ typedef enum {
   RUNPROCESS,
   SETPROCESS,
   FDCLOSE,
-  NICE
+  NICE,
+  SLABINFO,
+  SCHEDBENCH,
+  SETTIMER,
+  GETTIMER,
+  SETQUANTUM,
+  GETQUANTUM,
+  GETTICKS,
+  VMSPLICE,
+  SPLICE,
+  MUTEXLOCKHANDLE,
+  MUTEXUNLOCKHANDLE,
+  SEMWAITHANDLE,
+  SEMPOSTHANDLE,
+  FUTEXWAIT,
+  FUTEXWAKE,
+  SEMWAITN,
+  SEMPOSTN,
+  CONDWAIT,
+  CONDSIGNAL,
+  CONDBROADCAST,
+  TTYMODE,
+  TTYLATENCY,
+  HANDOFF,
+  YIELD
 } Syscall;
 
 // WRITE
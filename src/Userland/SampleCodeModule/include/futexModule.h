@@ -0,0 +1,34 @@
+#ifndef FUTEX_MODULE_H
+#define FUTEX_MODULE_H
+
+// Mutexes and semaphores living in a user word. Taking or releasing them
+// without contention is a single atomic instruction, the kernel is only
+// entered (through a futex) to sleep or to wake sleepers up.
+
+// 0 unlocked, 1 locked, 2 locked with processes (maybe) sleeping on it
+typedef int fmutex_t;
+
+typedef struct {
+  int value;
+  int waiters;  // processes about to sleep or sleeping on value
+  int batchWaiters;  // the waiters among them asking for more than one unit
+} fsem_t;
+
+// Sleeps on address while it holds expected. Returns 0 once woken up, 1 if
+// the word had already changed
+int futexWait(int* address, int expected);
+// Wakes up to count processes sleeping on address, returns how many
+int futexWake(int* address, int count);
+
+void fmutexInit(fmutex_t* mutex);
+void fmutexLock(fmutex_t* mutex);
+void fmutexUnlock(fmutex_t* mutex);
+
+void fsemInit(fsem_t* sem, int value);
+void fsemWait(fsem_t* sem);
+void fsemPost(fsem_t* sem);
+// Take or add count units at once
+void fsemWaitN(fsem_t* sem, int count);
+void fsemPostN(fsem_t* sem, int count);
+
+#endif
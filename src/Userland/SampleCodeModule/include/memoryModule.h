@@ -7,5 +7,6 @@ void* malloc(size_t size);
 void* realloc(void* source, size_t size);
 void free(void* source);
 void printNode(void* source);
+void printSlabs();
 
 #endif
@@ -4,9 +4,15 @@
 #include <stddef.h>
 #define MAX_MUTEX_ID 15
 
-void mutexOpen(char id[MAX_MUTEX_ID]);
+// Opens the mutex, creating it if needed, and returns a handle to it
+// (-1 if it could not be opened)
+int mutexOpen(char id[MAX_MUTEX_ID]);
 void mutexClose(char id[MAX_MUTEX_ID]);
+// Lock and unlock by name look the mutex up on every call
 void mutexLock(char id[MAX_MUTEX_ID]);
 void mutexUnlock(char id[MAX_MUTEX_ID]);
+// Lock and unlock by the handle mutexOpen returned, without any lookup
+void mutexLockHandle(int handle);
+void mutexUnlockHandle(int handle);
 
 #endif
@@ -1,6 +1,8 @@
 #ifndef PROCESSMODULE_H
 #define PROCESSMODULE_H
 
+#include <stdint.h>
+
 #define HIGHP 250
 #define MIDP 150
 #define LOWP 50
@@ -8,26 +10,62 @@
 #define STD_IN 0
 #define STD_OUT 1
 
+// waitpid options and pid
+#define WNOHANG 1     // return 0 instead of blocking if no child ended yet
+#define ANY_CHILD -1  // wait for whichever child ends first
+#define KILLED_STATUS -1
+
 typedef struct tProcessData {
   unsigned long int pid;
   char* name;
   char* status;
   int memory;
   char* priority;
+  unsigned long int ticks;
 } tProcessData;
 
+// Average cycles per scheduler operation
+typedef struct tSchedBench {
+  uint64_t drawCycles;
+  uint64_t walkCycles;
+  uint64_t addCycles;
+  uint64_t removeCycles;
+} tSchedBench;
+
 typedef int (*mainf)();
 
 unsigned long int createProcess(char* name, int (*entry)(int, char**), int argc,
                                 char** argv, int priority);
 void kill(unsigned long int);
 void getPS(tProcessData*** psVec, int* size);
-void waitpid(unsigned long int pid);
+// Waits for a child process to end, stores its exit status (if status is not
+// NULL) and returns its pid. Returns 0 if WNOHANG is given and no child ended
+// yet, -1 if there is no such child
+int waitpid(long int pid, int* status, int options);
 void runProcess(unsigned long int pid);
 unsigned long int setProcess(char* name, int (*entry)(int, char**), int argc,
                              char** argv, int priority);
-void pipe(int fd[2]);
+// Returns 0, or -1 if the pipe could not be created
+int pipe(int fd[2]);
 void dup(int pid, int fd, int pos);
 void closeFD(int fd);
+// Hands a malloc'd buffer to the pipe at fd without copying it, blocking
+// while the pipe holds too many. The buffer belongs to the pipe afterwards.
+// Returns bytes, or -1 (the buffer is still the caller's) if fd is not a pipe,
+// page is not a whole malloc'd block of at least bytes, or the kernel is out
+// of memory
+int vmsplice(int fd, void* page, int bytes);
+// Takes the next buffer out of the pipe at fd, stores it in page and returns
+// its size, or -1 if fd is not a pipe or out of memory. The buffer must be
+// freed
+int splice(int fd, void** page);
+void schedBench(int processes, int draws, tSchedBench* result);
+void setQuantum(int priority, int ticks);
+int getQuantum(int priority);
+// Turns on or off the direct switch to the process a semaphore post or
+// mutex unlock wakes up, and returns the previous setting
+int setHandoff(int enabled);
+// Gives the CPU to another ready process, the caller stays ready
+void yield();
 
 #endif
@@ -4,9 +4,26 @@
 #include <stddef.h>
 #define MAX_SEM_ID 15
 
-void semOpen(char id[MAX_SEM_ID], int start);
+// Opens the semaphore, creating it with start if needed, and returns a handle
+// to it (-1 if it could not be opened)
+int semOpen(char id[MAX_SEM_ID], int start);
 void semClose(char id[MAX_SEM_ID]);
+// Wait and post by name look the semaphore up on every call
 void semWait(char id[MAX_SEM_ID]);
 void semPost(char id[MAX_SEM_ID]);
+// Wait and post by the handle semOpen returned, without any lookup
+void semWaitHandle(int handle);
+void semPostHandle(int handle);
+// Take or add count units in a single call. Waiting blocks until all count
+// units are available, waiters are served in order
+void semWaitN(int handle, int count);
+void semPostN(int handle, int count);
+
+// Condition variables are semaphores opened with semOpen (and closed with
+// semClose). condWait unlocks the mutex (which the caller must hold), sleeps
+// until signaled and locks the mutex again
+void condWait(int cond, int mutexHandle);
+void condSignal(int cond);
+void condBroadcast(int cond);
 
 #endif
@@ -4,8 +4,28 @@
 #include <stdint.h>
 #include "./shell.h"
 
-void read(int fd, char* buff, int bytes);
-void write(int fd, char* buff, int bytes);
+// standard input modes (flags), see ttyMode
+#define TTY_RAW 0        // keys are readable as soon as they are typed
+#define TTY_CANONICAL 1  // the kernel edits the line, reads end at a newline
+#define TTY_ECHO 2       // the kernel prints the typed keys
+#define TTY_NONBLOCK 4   // reads return 0 instead of waiting for input
+#define TTY_DEFAULT (TTY_CANONICAL | TTY_ECHO)
+
+int read(int fd, char* buff, int bytes);
+int write(int fd, char* buff, int bytes);
+
+// Sets the console's standard input mode and returns the previous one
+int ttyMode(int mode);
+
+// Cycles from a key waking the readers up to one of them running again
+typedef struct tTtyLatency {
+  uint64_t samples;
+  uint64_t totalCycles;
+  uint64_t maxCycles;
+} tTtyLatency;
+
+// Gets the latencies measured since the last call
+void ttyLatency(tTtyLatency* result);
 
 // Prints string with formats
 void printf(char* fmt, ...);
@@ -16,17 +36,19 @@ void putChar(char c);
 // Prints decimal
 void putDec(int i);
 
-// Reads a char from buffer
+// Reads a char from the standard input, 0 if there is none and the input
+// does not block
 char getChar();
 
 // Trensforms a decimal to string
 char* decToStr(int num, char* buffer);
 
-// Scans from buffer and prints the contents scanned
-void scanAndPrint(char* buffer);
+// Reads a line (without its newline) into buffer, echoing it as it is typed.
+// What does not fit in size - 1 bytes is discarded
+void scanAndPrint(char* buffer, int size);
 
-// Scans from buffer
-void scan(char* buffer);
+// Like scanAndPrint, without echoing
+void scan(char* buffer, int size);
 
 // Compares two strings
 int strCmp(char* a, char* b);
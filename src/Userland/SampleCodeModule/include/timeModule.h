@@ -6,6 +6,8 @@
 #ifndef TIMEMODULE_H
 #define TIMEMODULE_H
 
+#include <stdint.h>
+
 unsigned int getHour();
 
 unsigned int getMinute();
@@ -14,4 +16,13 @@ unsigned int getSecond();
 
 void wait(int n);
 
+void setTimerFrequency(unsigned int hz);
+
+unsigned int getTimerFrequency();
+
+int getTicks();
+
+// Cycles since the processor was reset, for timing short operations
+uint64_t _rdtsc();
+
 #endif
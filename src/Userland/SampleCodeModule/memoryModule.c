@@ -23,3 +23,5 @@ void free(void* source) {
 void printNode(void* source) {
   systemCall((uint64_t)PRINTNODE, (uint64_t)source, 0, 0, 0, 0);
 }
+
+void printSlabs() { systemCall((uint64_t)SLABINFO, 0, 0, 0, 0, 0); }
@@ -2,8 +2,8 @@
 #include "include/SYSCall.h"
 #include "include/stdlib.h"
 
-void mutexOpen(char id[MAX_MUTEX_ID]) {
-  systemCall((uint64_t)MUTEXOPEN, (uint64_t)id, 0, 0, 0, 0);
+int mutexOpen(char id[MAX_MUTEX_ID]) {
+  return systemCall((uint64_t)MUTEXOPEN, (uint64_t)id, 0, 0, 0, 0);
 }
 void mutexClose(char id[MAX_MUTEX_ID]) {
   systemCall((uint64_t)MUTEXCLOSE, (uint64_t)id, 0, 0, 0, 0);
@@ -14,3 +14,9 @@ void mutexLock(char id[MAX_MUTEX_ID]) {
 void mutexUnlock(char id[MAX_MUTEX_ID]) {
   systemCall((uint64_t)MUTEXUNLOCK, (uint64_t)id, 0, 0, 0, 0);
 }
+void mutexLockHandle(int handle) {
+  systemCall((uint64_t)MUTEXLOCKHANDLE, (uint64_t)handle, 0, 0, 0, 0);
+}
+void mutexUnlockHandle(int handle) {
+  systemCall((uint64_t)MUTEXUNLOCKHANDLE, (uint64_t)handle, 0, 0, 0, 0);
+}
@@ -1,9 +1,8 @@
 #include "include/philosophers.h"
+#include "include/futexModule.h"
 #include "include/memoryModule.h"
-#include "include/mutexModule.h"
 #include "include/processModule.h"
 #include "include/queue.h"
-#include "include/semModule.h"
 #include "include/stdlib.h"
 #include "include/timeModule.h"
 #include "include/videoModule.h"
@@ -27,13 +26,17 @@ static int killing;
 static int id, indexToDie;
 static philosopher_t philosophers[MAX_PHILOSOPHERS] = {{0}};
 static queue_t thinkingList, eatingList;
+// shared by every philosopher process
+static fmutex_t philosMutex, listsMutex;
+static fsem_t chopsticks, inTable;
 void philosophersRun() {
+  int mode = ttyMode(TTY_RAW);
   printMenu();
-  mutexOpen("philosophers");
-  mutexOpen("lists");
+  fmutexInit(&philosMutex);
+  fmutexInit(&listsMutex);
   philosophersQty = 0;
-  semOpen("chopsticks", 0);
-  semOpen("inTable", 0);
+  fsemInit(&chopsticks, 0);
+  fsemInit(&inTable, 0);
   killing = 0;
   id = 0;
   indexToDie = 0;
@@ -54,10 +57,7 @@ void philosophersRun() {
     }
   }
   philosophersKillAll();
-  mutexClose("philosophers");
-  mutexClose("lists");
-  semClose("chopsticks");
-  semClose("inTable");
+  ttyMode(mode);
   printf("End of program\n");
 }
 
@@ -71,20 +71,20 @@ static void printMenu() {
 }
 
 static void philosopherCreate() {
-  mutexLock("philosophers");
+  fmutexLock(&philosMutex);
   if (philosophersQty >= MAX_PHILOSOPHERS) {
     printf("\nThe max capacity for philosophers has been reached.\n");
-    mutexUnlock("philosophers");
+    fmutexUnlock(&philosMutex);
     return;
   }
   if (killing == 1) {
     printf(
         "\nPlease wait for the philosopher to die before creating a new "
         "one\n\n");
-        mutexUnlock("philosophers");
+        fmutexUnlock(&philosMutex);
         return;
   }
-  semPost("chopsticks");
+  fsemPost(&chopsticks);
   int index = id++;
   philosopher_t phi = {};
   phi.pid =
@@ -92,14 +92,14 @@ static void philosopherCreate() {
   phi.id = index;
   indexToDie = index;
   philosophers[philosophersQty++] = phi;
-  if (philosophersQty > 1) semPost("inTable");
-  mutexUnlock("philosophers");
+  if (philosophersQty > 1) fsemPost(&inTable);
+  fmutexUnlock(&philosMutex);
 
   printf("\nphilosopher %d has been created :)\n\n", index);
 
-  mutexLock("lists");
+  fmutexLock(&listsMutex);
   queueOffer(thinkingList, &index);
-  mutexUnlock("lists");
+  fmutexUnlock(&listsMutex);
 }
 static int cmp(void* a, void* b) {
   int left = *((int*)a);
@@ -111,47 +111,47 @@ static int philosopher(int argc, char** argv) {
 
   while (1) {
     wait(1);
-    mutexLock("philosophers");
+    fmutexLock(&philosMutex);
     if (killing && i == indexToDie) {
-      mutexUnlock("philosophers");
+      fmutexUnlock(&philosMutex);
       philosopherSelfdestruct();
     }
-    mutexUnlock("philosophers");
-    semWait("inTable");
-    semWait("chopsticks");
-    semWait("chopsticks");
+    fmutexUnlock(&philosMutex);
+    fsemWait(&inTable);
+    fsemWait(&chopsticks);
+    fsemWait(&chopsticks);
 
-    mutexLock("lists");
+    fmutexLock(&listsMutex);
     queueRemove(thinkingList, &cmp, &i);
     queueOffer(eatingList, &i);
     printStatus();
-    mutexUnlock("lists");
+    fmutexUnlock(&listsMutex);
 
     wait(30);
-    semPost("chopsticks");
-    semPost("chopsticks");
-    semPost("inTable");
+    fsemPost(&chopsticks);
+    fsemPost(&chopsticks);
+    fsemPost(&inTable);
 
-    mutexLock("lists");
+    fmutexLock(&listsMutex);
     queueRemove(eatingList, &cmp, &i);
     queueOffer(thinkingList, &i);
-    mutexUnlock("lists");
+    fmutexUnlock(&listsMutex);
   }
   return 0;
 }
 
 static void philosopherKill() {
-  mutexLock("philosophers");
+  fmutexLock(&philosMutex);
   if (philosophersQty == 0) {
     printf("\nAll philosophers are already dead...\n");
-    mutexUnlock("philosophers");
+    fmutexUnlock(&philosMutex);
     return;
   }
   if (philosophersQty == 1) {
     printf(
         "\nplease create at least 2 philosophers before starting "
         "to kill them\n");
-    mutexUnlock("philosophers");
+    fmutexUnlock(&philosMutex);
     return;
   }
 
@@ -162,28 +162,28 @@ static void philosopherKill() {
     printf("\nwait for the philosopher to die before killing another one\n\n");
   }
 
-  mutexUnlock("philosophers");
+  fmutexUnlock(&philosMutex);
 }
 
 static void philosopherSelfdestruct() {
-  mutexLock("philosophers");
+  fmutexLock(&philosMutex);
   philosophersQty--;
   indexToDie = (philosophers[philosophersQty - 1]).id;
   philosopher_t philosopherToDie = philosophers[philosophersQty];
-  mutexUnlock("philosophers");
-  semWait("inTable");
-  semWait("chopsticks");
-  mutexLock("lists");
+  fmutexUnlock(&philosMutex);
+  fsemWait(&inTable);
+  fsemWait(&chopsticks);
+  fmutexLock(&listsMutex);
   queueRemove(thinkingList, &cmp, &(philosopherToDie.id));
   // queueRemove(eatingList, &cmp, &(philosopherToDie.id));
-  mutexUnlock("lists");
+  fmutexUnlock(&listsMutex);
   printf("\nphilosopher %d has died :(\n\n", philosopherToDie.id);
   killing = 0;
   kill(philosopherToDie.pid);
 }
 
 static void philosophersKillAll() {
-  mutexLock("philosophers");
+  fmutexLock(&philosMutex);
   for (int i = 0; i < philosophersQty; i++) {
     kill((philosophers[i]).pid);
   }
@@ -191,7 +191,7 @@ static void philosophersKillAll() {
   queueFree(eatingList);
   queueFree(thinkingList);
 
-  mutexUnlock("philosophers");
+  fmutexUnlock(&philosMutex);
 }
 static int printList(queue_t queue) {
   int usedSpaces = 0;
@@ -103,16 +103,20 @@ void startPong() {
       "BACKSPACE TO QUIT. YOU MAY QUIT ANYTIME DURING GAME~~";
   putStr(str);
 
+  int mode = ttyMode(TTY_RAW);
   char c;
   while ((c = getChar()) != '\b' && c != '\n' && c != 'r') {
   }
   if (c == '\b') {
+    ttyMode(mode);
     return;
   }
   rainbow = (c == 'r' ? 1 : 0);
   drawRectangle(black, xResolution / 2, 20, (xResolution / 2) - 60, 10);
 
+  ttyMode(TTY_NONBLOCK);
   int exitStatus = play(ball, p1, p2);
+  ttyMode(mode);
 
   if (exitStatus == 0) {
     return;
@@ -164,8 +168,10 @@ static void act(char command, Player p1, Player p2) {
       break;
     case PAUSE:
       printPause();
+      ttyMode(TTY_RAW);
       while (getChar() != '\n') {
       }
+      ttyMode(TTY_NONBLOCK);
       delPause();
     case RAINBOW:
       rainbow = !rainbow;
@@ -18,8 +18,9 @@ void getPS(tProcessData*** psVec, int* size) {
   systemCall((uint64_t)PS, (uint64_t)psVec, (uint64_t)size, 0, 0, 0);
 }
 
-void waitpid(unsigned long int pid) {
-  systemCall((uint64_t)WAITPID, (uint64_t)pid, 0, 0, 0, 0);
+int waitpid(long int pid, int* status, int options) {
+  return systemCall((uint64_t)WAITPID, (uint64_t)pid, (uint64_t)status,
+                    (uint64_t)options, 0, 0);
 }
 
 void runProcess(unsigned long int pid) {
@@ -34,7 +35,9 @@ unsigned long int setProcess(char* name, int (*entry)(int, char**), int argc,
   return pid;
 }
 
-void pipe(int fd[2]) { systemCall((uint64_t)PIPE, (uint64_t)fd, 0, 0, 0, 0); }
+int pipe(int fd[2]) {
+  return systemCall((uint64_t)PIPE, (uint64_t)fd, 0, 0, 0, 0);
+}
 
 void dup(int pid, int fd, int pos) {
   systemCall((uint64_t)DUP, (uint64_t)pid, (uint64_t)fd, (uint64_t)pos, 0, 0);
@@ -43,3 +46,35 @@ void dup(int pid, int fd, int pos) {
 void closeFD(int fd) {
   systemCall((uint64_t)FDCLOSE, (uint64_t)fd, 0, 0, 0, 0);
 }
+
+int vmsplice(int fd, void* page, int bytes) {
+  return systemCall((uint64_t)VMSPLICE, (uint64_t)fd, (uint64_t)page,
+                    (uint64_t)bytes, 0, 0);
+}
+
+int splice(int fd, void** page) {
+  return systemCall((uint64_t)SPLICE, (uint64_t)fd, (uint64_t)page, 0, 0, 0);
+}
+
+void schedBench(int processes, int draws, tSchedBench* result) {
+  systemCall((uint64_t)SCHEDBENCH, (uint64_t)processes, (uint64_t)draws,
+             (uint64_t)result, 0, 0);
+}
+
+void setQuantum(int priority, int ticks) {
+  systemCall((uint64_t)SETQUANTUM, (uint64_t)priority, (uint64_t)ticks, 0, 0,
+             0);
+}
+
+int setHandoff(int enabled) {
+  return systemCall((uint64_t)HANDOFF, (uint64_t)enabled, 0, 0, 0, 0);
+}
+
+void yield() { systemCall((uint64_t)YIELD, 0, 0, 0, 0, 0); }
+
+int getQuantum(int priority) {
+  int ticks;
+  systemCall((uint64_t)GETQUANTUM, (uint64_t)priority, (uint64_t)&ticks, 0, 0,
+             0);
+  return ticks;
+}
@@ -1,14 +1,14 @@
 #include "include/prodCon.h"
+#include "include/futexModule.h"
 #include "include/memoryModule.h"
-#include "include/mutexModule.h"
 #include "include/processModule.h"
-#include "include/semModule.h"
 #include "include/stdlib.h"
 #include "include/timeModule.h"
 #include "include/videoModule.h"
 
 #define INITPROD 2
 #define INITCONS 2
+#define BATCH 3  // items a producer makes before publishing them at once
 
 typedef enum { EXIT, ADDPROD, ADDCONS, DELPROD, DELCONS, INVCOM } prodconcom;
 
@@ -35,6 +35,8 @@ static int products_size;
 static int prod_size;
 static int cons_size;
 static int showProcPid;
+static fmutex_t buffMutex;
+static fsem_t itemsSem;
 
 static int on = 1;
 
@@ -49,14 +51,14 @@ void startProdCon() {
   cons_size = 0;
   printInitScreen();
   setCursor(250, 100);
-  mutexOpen("prodConBuff");
-  semOpen("prodConItems", 0);
+  fmutexInit(&buffMutex);
+  fsemInit(&itemsSem, 0);
   createShowProc();
   createInitProd(INITPROD);
   createInitCons(INITCONS);
   while (on) {
     clearBuffer(action);
-    scan(action);
+    scan(action, sizeof(action));
     int cmd = getcmd(action);
     switch (cmd) {
       case EXIT:
@@ -93,8 +95,6 @@ void startProdCon() {
   for (int i = 0; i < cons_size; i++) {
     kill(cons[i]);
   }
-  mutexClose("prodConBuff");
-  semClose("prodConItems");
   clearScreen();
 }
 
@@ -192,28 +192,31 @@ void deleteCons() {
   cons_size--;
 }
 
+// The whole batch is published with a single post
 void producer() {
   while (1) {
-    mutexLock("prodConBuff");
-    if (products_size < 10) {
+    fmutexLock(&buffMutex);
+    int made = 0;
+    while (made < BATCH && products_size < 10) {
       products[products_size]++;
       products_size++;
-      semPost("prodConItems");
+      made++;
     }
-    mutexUnlock("prodConBuff");
+    fmutexUnlock(&buffMutex);
+    if (made > 0) fsemPostN(&itemsSem, made);
     wait(30);
   }
 }
 
 void consumer() {
   while (1) {
-    semWait("prodConItems");
-    mutexLock("prodConBuff");
+    fsemWait(&itemsSem);
+    fmutexLock(&buffMutex);
     if (products_size > 0) {
       products[products_size - 1]--;
       products_size--;
     }
-    mutexUnlock("prodConBuff");
+    fmutexUnlock(&buffMutex);
     wait(30);
   }
 }
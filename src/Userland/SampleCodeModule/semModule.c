@@ -3,8 +3,8 @@
 // test
 #include "include/stdlib.h"
 
-void semOpen(char id[MAX_SEM_ID], int start) {
-  systemCall((uint64_t)SEMOPEN, (uint64_t)id, (uint64_t)start, 0, 0, 0);
+int semOpen(char id[MAX_SEM_ID], int start) {
+  return systemCall((uint64_t)SEMOPEN, (uint64_t)id, (uint64_t)start, 0, 0, 0);
 }
 void semClose(char id[MAX_SEM_ID]) {
   systemCall((uint64_t)SEMCLOSE, (uint64_t)id, 0, 0, 0, 0);
@@ -15,3 +15,25 @@ void semWait(char id[MAX_SEM_ID]) {
 void semPost(char id[MAX_SEM_ID]) {
   systemCall((uint64_t)SEMPOST, (uint64_t)id, 0, 0, 0, 0);
 }
+void semWaitHandle(int handle) {
+  systemCall((uint64_t)SEMWAITHANDLE, (uint64_t)handle, 0, 0, 0, 0);
+}
+void semPostHandle(int handle) {
+  systemCall((uint64_t)SEMPOSTHANDLE, (uint64_t)handle, 0, 0, 0, 0);
+}
+void semWaitN(int handle, int count) {
+  systemCall((uint64_t)SEMWAITN, (uint64_t)handle, (uint64_t)count, 0, 0, 0);
+}
+void semPostN(int handle, int count) {
+  systemCall((uint64_t)SEMPOSTN, (uint64_t)handle, (uint64_t)count, 0, 0, 0);
+}
+void condWait(int cond, int mutexHandle) {
+  systemCall((uint64_t)CONDWAIT, (uint64_t)cond, (uint64_t)mutexHandle, 0, 0,
+             0);
+}
+void condSignal(int cond) {
+  systemCall((uint64_t)CONDSIGNAL, (uint64_t)cond, 0, 0, 0, 0);
+}
+void condBroadcast(int cond) {
+  systemCall((uint64_t)CONDBROADCAST, (uint64_t)cond, 0, 0, 0, 0);
+}
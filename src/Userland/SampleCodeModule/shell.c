@@ -7,11 +7,15 @@
 #include "include/pongModule.h"
 #include "include/processModule.h"
 #include "include/prodCon.h"
+#include "include/semModule.h"
 #include "include/soundModule.h"
 #include "include/stdlib.h"
 #include "include/timeModule.h"
 #include "include/videoModule.h"
 
+#define BENCH_CHUNK 4096
+#define SPINNERS 2  // CPU bound processes pingpong competes with
+
 typedef enum {
   INVCOM,
   HELP,
@@ -34,7 +38,14 @@ typedef enum {
   NICE,
   DUMMY,
   PRODUCER,
-  CONSUMER
+  CONSUMER,
+  SLABINFO,
+  SCHEDBENCH,
+  TIMER,
+  QUANTUM,
+  PIPEBENCH,
+  KEYLAT,
+  PINGPONG
 } Command;
 
 void _opCode();
@@ -90,6 +101,29 @@ static void producerProc();
 // Spawns a consumer process that reads lines from stdout
 static unsigned long int consumer();
 static void consumerProc();
+// Displays the kernel object caches stats
+static unsigned long int slabInfo();
+// Shows the cycles each scheduler operation takes
+static unsigned long int schedBenchmark();
+// Shows or changes the timer frequency
+static unsigned long int timer();
+// Shows or changes the time slice of a priority
+static unsigned long int quantum();
+// Measures the pipe throughput moving the given MiB between two processes
+static unsigned long int pipeBench();
+static void benchWriter();
+static void benchReader();
+static void spliceWriter();
+static void spliceReader();
+// Shows how long readers took to run after a key woke them up
+static unsigned long int keyLatency();
+// Measures a semaphore round trip between two processes while others keep
+// the CPU busy, with and without handoff
+static unsigned long int pingPong();
+static int roundTrip();
+static void pinger();
+static void ponger();
+static void spinner();
 
 static unsigned long int mutex();
 static void pTest();
@@ -102,13 +136,23 @@ static cmd command_array[] = {
     (cmd)exit,     (cmd)pTestWrapper, (cmd)memTest,   (cmd)ps,
     (cmd)killTest, (cmd)stackOv,      (cmd)mutex,     (cmd)prodCon,
     (cmd)pipeTest, (cmd)philosophers, (cmd)nice,      (cmd)dummy,
-    (cmd)producer, (cmd)consumer};
+    (cmd)producer, (cmd)consumer,     (cmd)slabInfo,  (cmd)schedBenchmark,
+    (cmd)timer,    (cmd)quantum,      (cmd)pipeBench, (cmd)keyLatency,
+    (cmd)pingPong};
 
 static int sonsVec[50];
 static int sonsSize = 0;
 static int on;
 static int foreground;
 static int toPipe;
+static int benchBytes;
+// process stacks are too small to hold the transfer buffers
+static char benchOut[BENCH_CHUNK];
+static char benchIn[BENCH_CHUNK];
+static int pingRounds;
+static int pingSem, pongSem;
+static char pingName[MAX_SEM_ID] = "ping";
+static char pongName[MAX_SEM_ID] = "pong";
 
 static char argv[MAX_ARGUMENTS][MAXLEN];
 
@@ -121,10 +165,12 @@ void initShell() {
   while (on) {
     foreground = 1;
     toPipe = 0;
+    // reap the background jobs that already ended
+    while (waitpid(ANY_CHILD, NULL, WNOHANG) > 0) {
+    }
     printf("\n$> ");
     clearBuffer(command);
-    scanAndPrint(command);
-    printf("\n");
+    scanAndPrint(command, MAXLEN);
     int com = getCommand(command);
 
     int pid = command_array[com]();
@@ -143,8 +189,8 @@ void initShell() {
     if (pid != 0) runProcess(pid);
     if (pid == 0) foreground = 0;
     if (foreground == 1) {
-      waitpid(pid);
-      if (toPipe) waitpid(pid2);
+      waitpid(pid, NULL, 0);
+      if (toPipe) waitpid(pid2, NULL, 0);
     }
   }
   printf("\n\n End of program");
@@ -184,6 +230,13 @@ static int getCommand(char* command) {
   if (!strCmp("pipetest", argv[0])) return PIPETEST;
   if (!strCmp("producer", argv[0])) return PRODUCER;
   if (!strCmp("consumer", argv[0])) return CONSUMER;
+  if (!strCmp("slabinfo", argv[0])) return SLABINFO;
+  if (!strCmp("schedbench", argv[0])) return SCHEDBENCH;
+  if (!strCmp("timer", argv[0])) return TIMER;
+  if (!strCmp("quantum", argv[0])) return QUANTUM;
+  if (!strCmp("pipebench", argv[0])) return PIPEBENCH;
+  if (!strCmp("keylat", argv[0])) return KEYLAT;
+  if (!strCmp("pingpong", argv[0])) return PINGPONG;
   return INVCOM;
 }
 
@@ -210,6 +263,42 @@ static unsigned long int help() {
   printf("  * time         :       Displays current time\n");
   printf("  * prodcon      :       Launches ProdCon application\n");
   printf("  * memtest      :       Shows functioning Memory Management\n");
+  printf("  * slabinfo     :       Displays the kernel object caches stats\n");
+  printf(
+      "  * schedbench   :       Recieves an amount of processes (1000 by "
+      "default) and shows\n");
+  printf(
+      "                         the cycles each scheduler operation takes "
+      "with them ready\n");
+  printf(
+      "  * timer        :       Shows the timer frequency, or sets it to the "
+      "given Hz\n");
+  printf(
+      "  * quantum      :       Shows the ticks each priority runs before "
+      "being preempted,\n");
+  printf(
+      "                         or recieves a priority and ticks and sets "
+      "them\n");
+  printf(
+      "  * pipebench    :       Recieves an amount of MiB (4 by default) and "
+      "shows how fast\n");
+  printf(
+      "                         they go through a pipe between two "
+      "processes. Add 'splice'\n");
+  printf(
+      "                         to hand the pages over instead of copying "
+      "them\n");
+  printf(
+      "  * keylat       :       Shows the cycles from a key press to the "
+      "process reading it\n");
+  printf(
+      "                         running, since the last keylat\n");
+  printf(
+      "  * pingpong     :       Recieves an amount of rounds (1000 by "
+      "default) and shows the\n");
+  printf(
+      "                         cycles a semaphore round trip takes, with "
+      "and without handoff\n");
   printf(
       "  * ptest        :       Runs multiple processes to show "
       "functionality\n");
@@ -223,7 +312,7 @@ static unsigned long int help() {
       "process's priority\n");
   printf(
       "  * ps           :       Displays process table with, name, pid, "
-      "status, foreground, memory, priority\n");
+      "status, foreground, memory, priority, ticks run\n");
   printf(
       "  * dummy        :       Recieves a priority and a time and "
       "creates a dumy process that runs for that time\n");
@@ -323,11 +412,11 @@ static unsigned long int ps() {
   int size;
   getPS(&psVec, &size);
 
-  printf("PID     Status     Memory    Priority     Name\n");
+  printf("PID     Status     Memory    Priority     Ticks     Name\n");
   for (int i = 0; i < size; i++) {
-    printf("%d        %s    %d      %s      %s\n", psVec[i]->pid,
+    printf("%d        %s    %d      %s      %d      %s\n", psVec[i]->pid,
            psVec[i]->status, psVec[i]->memory, psVec[i]->priority,
-           psVec[i]->name);
+           (int)psVec[i]->ticks, psVec[i]->name);
     free(psVec[i]->name);
     free(psVec[i]);
   }
@@ -425,7 +514,7 @@ static unsigned long int mutex() {
   }
 
   for (int i = 0; i < kAmount; i++) {
-    waitpid(procs[i]);
+    waitpid(procs[i], NULL, 0);
   }
 
   mutexClose("pepe");
@@ -453,8 +542,8 @@ static void pTest() {
   int pid2 = createProcess("test2", (mainf)test2, 0, NULL, LOWP);
   sonsVec[sonsSize++] = pid1;
   sonsVec[sonsSize++] = pid2;
-  waitpid(pid1);
-  waitpid(pid2);
+  waitpid(pid1, NULL, 0);
+  waitpid(pid2, NULL, 0);
 }
 
 static unsigned long int killTest() {
@@ -505,7 +594,7 @@ static unsigned long int pipeTest() {
   char buff[50] = {0};
   read(fd[0], buff, 49);
   printf("(F) string read: %s.\n", buff);
-  waitpid(sonPid);
+  waitpid(sonPid, NULL, 0);
   closeFD(fd[0]);
   closeFD(fd[1]);
   return 0;
@@ -581,4 +670,183 @@ static void consumerProc() {
     read(STD_IN, buff, 49);
     printf("(%d) string read: %s\n", times++, buff);
   }
-}
\ No newline at end of file
+}
+
+static unsigned long int slabInfo() {
+  printSlabs();
+  return 0;
+}
+
+static unsigned long int schedBenchmark() {
+  int processes = 1000;
+  int draws = 1000;
+  if (argv[1][0] != 0) processes = atoi(argv[1]);
+  tSchedBench result = {0};
+  schedBench(processes, draws, &result);
+  printf("Scheduler cost with %d ready processes (cycles):\n", processes);
+  printf("  lottery draw : %d\n", (int)result.drawCycles);
+  printf("  range walk   : %d\n", (int)result.walkCycles);
+  printf("  add process  : %d\n", (int)result.addCycles);
+  printf("  remove       : %d\n", (int)result.removeCycles);
+  return 0;
+}
+
+static unsigned long int timer() {
+  if (argv[1][0] != 0) setTimerFrequency(atoi(argv[1]));
+  printf("Timer frequency: %d Hz\n", getTimerFrequency());
+  return 0;
+}
+
+static unsigned long int quantum() {
+  if (argv[1][0] != 0) setQuantum(getPriority(argv[1]), atoi(argv[2]));
+  printf("Time slices (ticks):\n");
+  printf("  HIGHP : %d\n", getQuantum(HIGHP));
+  printf("  MIDP  : %d\n", getQuantum(MIDP));
+  printf("  LOWP  : %d\n", getQuantum(LOWP));
+  return 0;
+}
+
+static unsigned long int pipeBench() {
+  int mib = 4;
+  if (argv[1][0] != 0) mib = atoi(argv[1]);
+  benchBytes = mib * 1024 * 1024;
+  int spliced = !strCmp("splice", argv[2]);
+  mainf writerMain = spliced ? (mainf)spliceWriter : (mainf)benchWriter;
+  mainf readerMain = spliced ? (mainf)spliceReader : (mainf)benchReader;
+  int writer = setProcess("BenchWriter", writerMain, 0, NULL, MIDP);
+  int reader = setProcess("BenchReader", readerMain, 0, NULL, MIDP);
+  int fd[2];
+  pipe(fd);
+  dup(writer, fd[1], STD_OUT);
+  dup(reader, fd[0], STD_IN);
+  closeFD(fd[0]);
+  closeFD(fd[1]);
+  int start = getTicks();
+  runProcess(reader);
+  runProcess(writer);
+  waitpid(writer, NULL, 0);
+  waitpid(reader, NULL, 0);
+  int ticks = getTicks() - start;
+  if (ticks == 0) ticks = 1;
+  printf("Piped %d MiB in %d ticks\n", mib, ticks);
+  printf("Throughput: %d KiB/s\n",
+         mib * 1024 * (int)getTimerFrequency() / ticks);
+  return 0;
+}
+
+static unsigned long int keyLatency() {
+  tTtyLatency result = {0};
+  ttyLatency(&result);
+  if (result.samples == 0) {
+    printf("No reader was woken up by a key yet\n");
+    return 0;
+  }
+  printf("Key to reader latency over %d keys (cycles):\n",
+         (int)result.samples);
+  printf("  average : %d\n", (int)(result.totalCycles / result.samples));
+  printf("  max     : %d\n", (int)result.maxCycles);
+  return 0;
+}
+
+static unsigned long int pingPong() {
+  pingRounds = 1000;
+  if (argv[1][0] != 0) pingRounds = atoi(argv[1]);
+  if (pingRounds < 1) pingRounds = 1;
+  int previous = setHandoff(0);
+  int policyOnly = roundTrip();
+  setHandoff(1);
+  int handoff = roundTrip();
+  setHandoff(previous);
+  printf("Semaphore round trip with %d busy processes (cycles):\n", SPINNERS);
+  printf("  policy only : %d\n", policyOnly);
+  printf("  handoff     : %d\n", handoff);
+  return 0;
+}
+
+// Average cycles per round trip, spinners competing with ping and pong
+static int roundTrip() {
+  pingSem = semOpen(pingName, 0);
+  pongSem = semOpen(pongName, 0);
+  int spinners[SPINNERS];
+  for (int i = 0; i < SPINNERS; i++) {
+    spinners[i] = createProcess("Spinner", (mainf)spinner, 0, NULL, MIDP);
+  }
+  uint64_t start = _rdtsc();
+  int ping = createProcess("Ping", (mainf)pinger, 0, NULL, MIDP);
+  int pong = createProcess("Pong", (mainf)ponger, 0, NULL, MIDP);
+  waitpid(ping, NULL, 0);
+  waitpid(pong, NULL, 0);
+  uint64_t cycles = _rdtsc() - start;
+  for (int i = 0; i < SPINNERS; i++) {
+    kill(spinners[i]);
+    waitpid(spinners[i], NULL, 0);
+  }
+  semClose(pingName);
+  semClose(pongName);
+  return (int)(cycles / pingRounds);
+}
+
+static void pinger() {
+  for (int i = 0; i < pingRounds; i++) {
+    semPostHandle(pongSem);
+    semWaitHandle(pingSem);
+  }
+}
+
+static void ponger() {
+  for (int i = 0; i < pingRounds; i++) {
+    semWaitHandle(pongSem);
+    semPostHandle(pingSem);
+  }
+}
+
+static void spinner() {
+  while (1) {
+  }
+}
+
+static void benchWriter() {
+  for (int i = 0; i < BENCH_CHUNK; i++) {
+    benchOut[i] = 'x';
+  }
+  for (int sent = 0; sent < benchBytes; sent += BENCH_CHUNK) {
+    write(STD_OUT, benchOut, BENCH_CHUNK);
+  }
+}
+
+static void benchReader() {
+  int received = 0;
+  while (received < benchBytes) {
+    received += read(STD_IN, benchIn, BENCH_CHUNK);
+  }
+}
+
+// Every chunk is a fresh page handed to the pipe, the reader frees it
+static void spliceWriter() {
+  int sent = 0;
+  while (sent < benchBytes) {
+    char* page = malloc(BENCH_CHUNK);
+    if (page == NULL) {
+      // the heap is full of queued pages, let the reader free some
+      yield();
+      continue;
+    }
+    page[0] = 'x';
+    if (vmsplice(STD_OUT, page, BENCH_CHUNK) == -1) {
+      free(page);
+      return;
+    }
+    sent += BENCH_CHUNK;
+  }
+}
+
+static void spliceReader() {
+  int received = 0;
+  while (received < benchBytes) {
+    void* page;
+    int bytes = splice(STD_IN, &page);
+    if (bytes == -1) return;
+    received += bytes;
+    free(page);
+  }
+}
@@ -88,12 +88,13 @@ void putStr(char* str) {
              (uint64_t)strLen(str) + 1, 0, 0);
 }
 
-void read(int fd, char* buff, int bytes) {
-  systemCall((uint64_t)READ, (uint64_t)fd, (uint64_t)buff, bytes, 0, 0);
+int read(int fd, char* buff, int bytes) {
+  return systemCall((uint64_t)READ, (uint64_t)fd, (uint64_t)buff, bytes, 0, 0);
 }
 
-void write(int fd, char* buff, int bytes) {
-  systemCall((uint64_t)WRITE, (uint64_t)fd, (uint64_t)buff, bytes, 0, 0);
+int write(int fd, char* buff, int bytes) {
+  return systemCall((uint64_t)WRITE, (uint64_t)fd, (uint64_t)buff, bytes, 0,
+                    0);
 }
 
 char* decToStr(int num, char* buffer) {
@@ -117,50 +118,39 @@ char* decToStr(int num, char* buffer) {
 }
 
 char getChar() {
-  char c;
+  char c = 0;
   systemCall((uint64_t)READ, (uint64_t)STD_IN, (uint64_t)&c, 1, 0, 0);
   return c;
 }
 
-void scanAndPrint(char* buffer) {
-  char c;
-  char* p = buffer;
-  int idx = 0;
-  while ((c = getChar()) != '\n') {
-    if ((c > 31 && c < 127) || c == '\b' || c == '\n') {
-      if (c == '\b' && idx > 0) {
-        deleteChar();
-        p--;
-        idx--;
-      } else if (c != '\b') {
-        putChar(c);
-        *p = c;
-        p++;
-        idx++;
-      }
-    }
-  }
-  *p = 0;
+int ttyMode(int mode) {
+  return systemCall((uint64_t)TTYMODE, (uint64_t)mode, 0, 0, 0, 0);
 }
 
-void scan(char* buffer) {
-  char c;
-  char* p = buffer;
-  int idx = 0;
-  while ((c = getChar()) != '\n') {
-    if ((c > 31 && c < 127) || c == '\b' || c == '\n') {
-      if (c == '\b' && idx > 0) {
-        deleteChar();
-        p--;
-        idx--;
-      } else if (c != '\b') {
-        *p = c;
-        p++;
-        idx++;
-      }
+void ttyLatency(tTtyLatency* result) {
+  systemCall((uint64_t)TTYLATENCY, (uint64_t)result, 0, 0, 0, 0);
+}
+
+// The kernel hands over a whole line per read
+static void readLine(char* buffer, int size) {
+  int len = read(STD_IN, buffer, size - 1);
+  if (len < 0) len = 0;
+  if (len > 0 && buffer[len - 1] == '\n') {
+    len--;
+  } else {
+    char c;
+    while (read(STD_IN, &c, 1) == 1 && c != '\n') {
     }
   }
-  *p = 0;
+  buffer[len] = 0;
+}
+
+void scanAndPrint(char* buffer, int size) { readLine(buffer, size); }
+
+void scan(char* buffer, int size) {
+  int mode = ttyMode(TTY_CANONICAL);
+  readLine(buffer, size);
+  ttyMode(mode);
 }
 
 void clearBuffer(char* buffer) {
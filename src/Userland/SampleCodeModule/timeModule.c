@@ -26,3 +26,19 @@ unsigned int getSecond() {
 }
 
 void wait(int n) { systemCall((uint64_t)WAIT, (uint64_t)&n, 0, 0, 0, 0); }
+
+void setTimerFrequency(unsigned int hz) {
+  systemCall((uint64_t)SETTIMER, (uint64_t)hz, 0, 0, 0, 0);
+}
+
+unsigned int getTimerFrequency() {
+  unsigned int hz;
+  systemCall((uint64_t)GETTIMER, (uint64_t)&hz, 0, 0, 0, 0);
+  return hz;
+}
+
+int getTicks() {
+  int ticks;
+  systemCall((uint64_t)GETTICKS, (uint64_t)&ticks, 0, 0, 0, 0);
+  return ticks;
+}
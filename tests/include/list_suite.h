@@ -0,0 +1,9 @@
+
+#ifndef LIST_SUITE_H
+#define LIST_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_list_tests(CU_pSuite pSuite);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef MLFQ_SUITE_H
+#define MLFQ_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_mlfq_tests(CU_pSuite pSuite);
+
+#endif
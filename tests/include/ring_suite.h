@@ -0,0 +1,8 @@
+#ifndef RING_SUITE_H
+#define RING_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_ring_tests(CU_pSuite pSuite);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef SEMAPHORE_SUITE_H
+#define SEMAPHORE_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_semaphore_tests(CU_pSuite pSuite);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef TICKET_TREE_SUITE_H
+#define TICKET_TREE_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_ticketTree_tests(CU_pSuite pSuite);
+
+#endif
@@ -0,0 +1,8 @@
+#ifndef TIMER_WHEEL_SUITE_H
+#define TIMER_WHEEL_SUITE_H
+
+#include "CUnit/Basic.h"
+
+int add_timerWheel_tests(CU_pSuite pSuite);
+
+#endif
@@ -0,0 +1,97 @@
+#include "../src/Kernel/list.c"
+#include "CUnit/Basic.h"
+
+typedef struct tWaiter {
+  unsigned long int pid;
+  tLink waitLink;
+} tWaiter;
+
+static tList list;
+static tWaiter waiters[3];
+static void setup() {
+  listInit(&list);
+  for (int i = 0; i < 3; i++) {
+    waiters[i].pid = i + 1;
+    linkInit(&waiters[i].waitLink);
+  }
+}
+
+void empty_list_test() {
+  setup();
+  CU_ASSERT_TRUE(listIsEmpty(&list));
+  CU_ASSERT_EQUAL(listSize(&list), 0);
+  CU_ASSERT_PTR_NULL(listFront(&list));
+  CU_ASSERT_PTR_NULL(listPopFront(&list));
+}
+
+void pop_right_order_test() {
+  setup();
+  for (int i = 0; i < 3; i++) listPushBack(&list, &waiters[i].waitLink);
+  CU_ASSERT_EQUAL(listSize(&list), 3);
+
+  for (int i = 0; i < 3; i++) {
+    tLink* link = listPopFront(&list);
+    CU_ASSERT_PTR_NOT_NULL(link);
+    CU_ASSERT_EQUAL(listEntry(link, tWaiter, waitLink)->pid, i + 1);
+    CU_ASSERT_FALSE(linkIsLinked(link));
+  }
+  CU_ASSERT_TRUE(listIsEmpty(&list));
+}
+
+void remove_middle_test() {
+  setup();
+  for (int i = 0; i < 3; i++) listPushBack(&list, &waiters[i].waitLink);
+  listRemove(&waiters[1].waitLink);
+  CU_ASSERT_EQUAL(listSize(&list), 2);
+  CU_ASSERT_EQUAL(listEntry(listPopFront(&list), tWaiter, waitLink)->pid, 1);
+  CU_ASSERT_EQUAL(listEntry(listPopFront(&list), tWaiter, waitLink)->pid, 3);
+}
+
+void remove_detached_test() {
+  setup();
+  listPushBack(&list, &waiters[0].waitLink);
+  listRemove(&waiters[2].waitLink);
+  CU_ASSERT_EQUAL(listSize(&list), 1);
+  listRemove(&waiters[0].waitLink);
+  listRemove(&waiters[0].waitLink);
+  CU_ASSERT_TRUE(listIsEmpty(&list));
+}
+
+void reuse_link_test() {
+  setup();
+  tList other;
+  listInit(&other);
+  listPushBack(&list, &waiters[0].waitLink);
+  listRemove(&waiters[0].waitLink);
+  listPushBack(&other, &waiters[0].waitLink);
+  CU_ASSERT_TRUE(listIsEmpty(&list));
+  CU_ASSERT_PTR_EQUAL(listFront(&other), &waiters[0].waitLink);
+}
+
+void move_all_test() {
+  setup();
+  tList other;
+  listInit(&other);
+  listPushBack(&list, &waiters[0].waitLink);
+  listPushBack(&other, &waiters[1].waitLink);
+  listPushBack(&other, &waiters[2].waitLink);
+  listMoveAll(&other, &list);
+  CU_ASSERT_TRUE(listIsEmpty(&other));
+  CU_ASSERT_EQUAL(listSize(&list), 3);
+  for (int i = 0; i < 3; i++) {
+    CU_ASSERT_EQUAL(listEntry(listPopFront(&list), tWaiter, waitLink)->pid,
+                    i + 1);
+  }
+  listMoveAll(&other, &list);
+  CU_ASSERT_TRUE(listIsEmpty(&list));
+}
+
+int add_list_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, empty_list_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, pop_right_order_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, remove_middle_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, remove_detached_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, reuse_link_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, move_all_test)) return 0;
+  return 1;
+}
@@ -0,0 +1,91 @@
+#define MLFQ_SCHED
+#include "../src/Kernel/mlfqScheduler.c"
+#include "CUnit/Basic.h"
+
+static tProcess procs[3];
+
+static void setup() {
+  policyInit();
+  for (int i = 0; i < 3; i++) {
+    procs[i].pid = i;
+    procs[i].priority = HIGHP;
+    linkInit(&procs[i].schedLink);
+    procs[i].schedLevel = NO_LEVEL;
+    procs[i].schedTicks = 0;
+  }
+  procs[2].priority = IDLE;
+}
+
+void round_robin_test() {
+  setup();
+  policyAdd(&procs[0]);
+  policyAdd(&procs[1]);
+  tProcess* first = policyNext(NULL);
+  CU_ASSERT_PTR_EQUAL(first, &procs[0]);
+  CU_ASSERT_PTR_EQUAL(policyNext(first), &procs[1]);
+}
+
+void idle_runs_last_test() {
+  setup();
+  policyAdd(&procs[2]);
+  policyAdd(&procs[0]);
+  CU_ASSERT_PTR_EQUAL(policyNext(NULL), &procs[0]);
+  policyRemove(&procs[0]);
+  CU_ASSERT_EQUAL(policyReadyCount(), 1);
+  CU_ASSERT_PTR_EQUAL(policyNext(&procs[0]), &procs[2]);
+}
+
+void demotion_test() {
+  setup();
+  policyAdd(&procs[0]);
+  tProcess* current = policyNext(NULL);
+  for (int i = 0; i < allotment[0]; i++) current = policyNext(current);
+  CU_ASSERT_EQUAL(procs[0].schedLevel, 1);
+  // a newcomer at the top level runs before the demoted process
+  policyAdd(&procs[1]);
+  CU_ASSERT_PTR_EQUAL(policyNext(current), &procs[1]);
+}
+
+void wake_promotion_test() {
+  setup();
+  procs[0].priority = LOWP;
+  policyAdd(&procs[0]);
+  CU_ASSERT_EQUAL(procs[0].schedLevel, LEVELS - 1);
+  policyRemove(&procs[0]);
+  policyWake(&procs[0]);
+  policyAdd(&procs[0]);
+  CU_ASSERT_EQUAL(procs[0].schedLevel, LEVELS - 2);
+}
+
+void boost_test() {
+  setup();
+  procs[0].priority = LOWP;
+  policyAdd(&procs[0]);
+  policyAdd(&procs[2]);
+  tProcess* current = NULL;
+  for (int i = 0; i < BOOST_PERIOD; i++) current = policyNext(current);
+  CU_ASSERT_EQUAL(procs[0].schedLevel, 0);
+  CU_ASSERT_EQUAL(procs[2].schedLevel, IDLE_LEVEL);
+}
+
+void wake_preemption_test() {
+  setup();
+  procs[1].priority = LOWP;
+  policyAdd(&procs[0]);
+  policyAdd(&procs[1]);
+  policyAdd(&procs[2]);
+  // a higher level takes the CPU, a lower one waits
+  CU_ASSERT_TRUE(policyPreempts(&procs[0], &procs[1]));
+  CU_ASSERT_FALSE(policyPreempts(&procs[1], &procs[0]));
+  CU_ASSERT_TRUE(policyPreempts(&procs[1], &procs[2]));
+}
+
+int add_mlfq_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, round_robin_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, idle_runs_last_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, demotion_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, wake_promotion_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, boost_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, wake_preemption_test)) return 0;
+  return 1;
+}
@@ -0,0 +1,115 @@
+#include "../src/Kernel/ring.c"
+#include <pthread.h>
+#include <sched.h>
+#include "CUnit/Basic.h"
+
+#define RING_SIZE 64
+#define STRESS_BYTES (1 << 20)
+#define MAX_CHUNK (RING_SIZE + 7)  // bigger than the ring on purpose
+
+static char storage[RING_SIZE];
+static tRing ring;
+
+void push_pop_test() {
+  ringInit(&ring, storage, RING_SIZE);
+  char c = 0;
+  CU_ASSERT_FALSE(ringPop(&ring, &c));
+  for (int i = 0; i < RING_SIZE; i++) {
+    CU_ASSERT_TRUE(ringPush(&ring, (char)i));
+  }
+  CU_ASSERT_FALSE(ringPush(&ring, 'x'));
+  CU_ASSERT_EQUAL(ringCount(&ring), RING_SIZE);
+  CU_ASSERT_TRUE(ringPop(&ring, &c));
+  CU_ASSERT_EQUAL(c, 0);
+  CU_ASSERT_EQUAL(ringSpace(&ring), 1);
+}
+
+// Bulk copies split at the end of the buffer and keep the byte order
+void wrap_around_test() {
+  ringInit(&ring, storage, RING_SIZE);
+  char in[RING_SIZE], out[RING_SIZE];
+  for (int i = 0; i < RING_SIZE; i++) in[i] = (char)i;
+  CU_ASSERT_EQUAL(ringWrite(&ring, in, 40), 40);
+  CU_ASSERT_EQUAL(ringRead(&ring, out, 40), 40);
+  // only RING_SIZE bytes fit, starting 40 bytes into the buffer
+  CU_ASSERT_EQUAL(ringWrite(&ring, in, RING_SIZE + 10), RING_SIZE);
+  CU_ASSERT_EQUAL(ringRead(&ring, out, RING_SIZE + 10), RING_SIZE);
+  CU_ASSERT_EQUAL(memcmp(in, out, RING_SIZE), 0);
+  CU_ASSERT_EQUAL(ringRead(&ring, out, 1), 0);
+}
+
+// The positions run freely and overflow, masking must still work
+void index_overflow_test() {
+  ringInit(&ring, storage, RING_SIZE);
+  ring.head = ring.tail = 0xFFFFFFF0u;
+  char in[32], out[32];
+  for (int i = 0; i < 32; i++) in[i] = (char)(i + 1);
+  CU_ASSERT_EQUAL(ringWrite(&ring, in, 32), 32);
+  CU_ASSERT_EQUAL(ringCount(&ring), 32);
+  CU_ASSERT_EQUAL(ringRead(&ring, out, 32), 32);
+  CU_ASSERT_EQUAL(memcmp(in, out, 32), 0);
+}
+
+// Producer and consumer on their own threads, mixing single bytes and bulk
+// copies of different sizes. The consumer checks every byte comes in order
+static void* producer(void* arg) {
+  char chunk[MAX_CHUNK];
+  unsigned int sent = 0, round = 0;
+  while (sent < STRESS_BYTES) {
+    if (ringSpace(&ring) == 0) {
+      sched_yield();  // let the consumer run when they share a core
+    } else if (round++ % 3 == 0) {
+      if (ringPush(&ring, (char)sent)) sent++;
+    } else {
+      unsigned int bytes = 1 + round % MAX_CHUNK;
+      if (bytes > STRESS_BYTES - sent) bytes = STRESS_BYTES - sent;
+      for (unsigned int i = 0; i < bytes; i++) chunk[i] = (char)(sent + i);
+      sent += ringWrite(&ring, chunk, bytes);
+    }
+  }
+  return NULL;
+}
+
+static void* consumer(void* arg) {
+  char chunk[MAX_CHUNK];
+  unsigned int received = 0, round = 0;
+  long errors = 0;
+  while (received < STRESS_BYTES) {
+    if (ringCount(&ring) == 0) {
+      sched_yield();
+    } else if (round++ % 2 == 0) {
+      char c;
+      if (ringPop(&ring, &c)) {
+        if (c != (char)received) errors++;
+        received++;
+      }
+    } else {
+      unsigned int bytes = ringRead(&ring, chunk, 1 + round % MAX_CHUNK);
+      for (unsigned int i = 0; i < bytes; i++) {
+        if (chunk[i] != (char)(received + i)) errors++;
+      }
+      received += bytes;
+    }
+  }
+  return (void*)errors;
+}
+
+void stress_test() {
+  ringInit(&ring, storage, RING_SIZE);
+  pthread_t prod, cons;
+  void* errors;
+  pthread_create(&cons, NULL, consumer, NULL);
+  pthread_create(&prod, NULL, producer, NULL);
+  pthread_join(prod, NULL);
+  pthread_join(cons, &errors);
+  CU_ASSERT_EQUAL((long)errors, 0);
+  CU_ASSERT_EQUAL(ringCount(&ring), 0);
+}
+
+int add_ring_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, push_pop_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, wrap_around_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, index_overflow_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, stress_test)) return 0;
+  return 1;
+}
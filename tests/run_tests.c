@@ -1,6 +1,12 @@
 #include "CUnit/Basic.h"
 #include "include/sum_suite.h"
 #include "include/queue_suite.h"
+#include "include/list_suite.h"
+#include "include/ticketTree_suite.h"
+#include "include/mlfq_suite.h"
+#include "include/timerWheel_suite.h"
+#include "include/ring_suite.h"
+#include "include/semaphore_suite.h"
 
 static CU_pSuite addSuiteToRegistry(char* suiteName);
 static int exitWithError();
@@ -13,7 +19,13 @@ typedef struct {
 // test suites
 suite_t suites[] = {
   {"sum_suite", &add_sum_tests},
-  {"queue_suite", &add_queue_tests}
+  {"queue_suite", &add_queue_tests},
+  {"list_suite", &add_list_tests},
+  {"ticketTree_suite", &add_ticketTree_tests},
+  {"mlfq_suite", &add_mlfq_tests},
+  {"timerWheel_suite", &add_timerWheel_tests},
+  {"ring_suite", &add_ring_tests},
+  {"semaphore_suite", &add_semaphore_tests}
 };
 
 int main(void) {
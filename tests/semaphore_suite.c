@@ -0,0 +1,144 @@
+#include "../src/Kernel/semaphore.c"
+#include "CUnit/Basic.h"
+
+#define PROCS 4
+
+// Stand-ins for the scheduler: blocking only queues the running process,
+// the tests then play the part of the processes it switches to
+static tProcess procs[PROCS];
+static tProcess* current;
+static tProcess* woken[PROCS];
+static int wokenCount;
+static tProcess* handedOff;
+static tSemaphore storage;
+
+tProcess* getCurrentProcess() { return current; }
+
+void waitOn(tList* waitList) {
+  listPushBack(waitList, &current->waitLink);
+  current->status = BLOCKED;
+}
+
+void wakeProcess(tProcess* proc) {
+  listRemove(&proc->waitLink);
+  proc->status = READY;
+  woken[wokenCount++] = proc;
+}
+
+tProcess* wakeOne(tList* waitList) {
+  tLink* link = listFront(waitList);
+  if (link == NULL) return NULL;
+  tProcess* proc = listEntry(link, tProcess, waitLink);
+  wakeProcess(proc);
+  return proc;
+}
+
+void handOff(tProcess* proc) { handedOff = proc; }
+
+void mutexLock(mutex_t mutex) {}
+
+void mutexUnlock(mutex_t mutex) {}
+
+slabCache_t slabCacheCreate(char* name, size_t objectSize) {
+  return (slabCache_t)&storage;
+}
+
+void* slabAlloc(slabCache_t cache) { return &storage; }
+
+void slabFree(slabCache_t cache, void* object) {}
+
+static sem_t setup(int value) {
+  for (int i = 0; i < PROCS; i++) {
+    linkInit(&procs[i].waitLink);
+    procs[i].status = READY;
+    procs[i].semUnits = 0;
+    procs[i].semBlockedOn = NULL;
+  }
+  wokenCount = 0;
+  handedOff = NULL;
+  return semCreate(value);
+}
+
+// The running process asks for count units, blocking if they are not there
+static void waitAs(int proc, sem_t sem, int count) {
+  current = &procs[proc];
+  semWaitN(sem, count);
+}
+
+void batch_fifo_test() {
+  sem_t sem = setup(0);
+  waitAs(0, sem, 2);
+  waitAs(1, sem, 1);
+  waitAs(2, sem, 1);
+  semPostN(sem, 3);
+  CU_ASSERT_EQUAL(wokenCount, 2);
+  CU_ASSERT_PTR_EQUAL(woken[0], &procs[0]);
+  CU_ASSERT_PTR_EQUAL(woken[1], &procs[1]);
+  CU_ASSERT_PTR_EQUAL(handedOff, &procs[0]);
+  CU_ASSERT_EQUAL(semGetValue(sem), 0);
+  CU_ASSERT_EQUAL(procs[2].status, BLOCKED);
+}
+
+void no_overtaking_test() {
+  sem_t sem = setup(1);
+  waitAs(0, sem, 3);
+  // a unit is there, but the bigger request came first
+  waitAs(1, sem, 1);
+  CU_ASSERT_EQUAL(procs[1].status, BLOCKED);
+  semPostN(sem, 1);
+  CU_ASSERT_EQUAL(wokenCount, 0);
+  CU_ASSERT_EQUAL(semGetValue(sem), 2);
+}
+
+void killed_head_test() {
+  sem_t sem = setup(0);
+  waitAs(0, sem, 5);
+  waitAs(1, sem, 1);
+  semPostN(sem, 3);
+  CU_ASSERT_EQUAL(wokenCount, 0);
+  // the head goes away, the units it held back reach the next waiter
+  semAbandon(&procs[0]);
+  CU_ASSERT_PTR_NULL(procs[0].semBlockedOn);
+  CU_ASSERT_EQUAL(wokenCount, 1);
+  CU_ASSERT_PTR_EQUAL(woken[0], &procs[1]);
+  CU_ASSERT_PTR_NULL(procs[1].semBlockedOn);
+  CU_ASSERT_EQUAL(semGetValue(sem), 2);
+}
+
+void abandon_granted_test() {
+  sem_t sem = setup(0);
+  waitAs(0, sem, 1);
+  semPostN(sem, 1);
+  // already granted, ending it gives nothing back
+  semAbandon(&procs[0]);
+  CU_ASSERT_EQUAL(wokenCount, 1);
+  CU_ASSERT_EQUAL(semGetValue(sem), 0);
+}
+
+void signal_broadcast_test() {
+  sem_t cond = setup(0);
+  mutex_t mutex = NULL;
+  for (int i = 0; i < 3; i++) {
+    current = &procs[i];
+    condWait(cond, mutex);
+  }
+  condSignal(cond);
+  CU_ASSERT_EQUAL(wokenCount, 1);
+  CU_ASSERT_PTR_EQUAL(woken[0], &procs[0]);
+  condBroadcast(cond);
+  CU_ASSERT_EQUAL(wokenCount, 3);
+  CU_ASSERT_PTR_EQUAL(woken[1], &procs[1]);
+  CU_ASSERT_PTR_EQUAL(woken[2], &procs[2]);
+  CU_ASSERT_TRUE(listIsEmpty(&cond->lockedList));
+  condSignal(cond);
+  CU_ASSERT_EQUAL(wokenCount, 3);
+}
+
+int add_semaphore_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, batch_fifo_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, no_overtaking_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, killed_head_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, abandon_granted_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, signal_broadcast_test)) return 0;
+  return 1;
+}
@@ -0,0 +1,63 @@
+#include "../src/Kernel/ticketTree.c"
+#include "CUnit/Basic.h"
+
+static tTicketTree tickets;
+
+// Slot owning the ticket by walking every slot, as the old range list did
+static int linearFind(int* slotTickets, int ticket) {
+  int slot = 0;
+  while (ticket >= slotTickets[slot]) {
+    ticket -= slotTickets[slot];
+    slot++;
+  }
+  return slot;
+}
+
+void empty_tree_test() {
+  ticketTreeInit(&tickets);
+  CU_ASSERT_EQUAL(ticketTreeTotal(&tickets), 0);
+}
+
+void single_slot_test() {
+  ticketTreeInit(&tickets);
+  ticketTreeAdd(&tickets, 7, 250);
+  CU_ASSERT_EQUAL(ticketTreeTotal(&tickets), 250);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 0), 7);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 249), 7);
+}
+
+void find_matches_ranges_test() {
+  static int slotTickets[MAX_SLOTS];
+  ticketTreeInit(&tickets);
+  for (int i = 0; i < MAX_SLOTS; i++) {
+    slotTickets[i] = (i % 3 == 0) ? 0 : (i % 7) * 50 + 1;
+    ticketTreeAdd(&tickets, i, slotTickets[i]);
+  }
+  int ok = 1;
+  for (int t = 0; t < ticketTreeTotal(&tickets); t += 13) {
+    if (ticketTreeFind(&tickets, t) != linearFind(slotTickets, t)) ok = 0;
+  }
+  CU_ASSERT_TRUE(ok);
+}
+
+void remove_and_change_test() {
+  ticketTreeInit(&tickets);
+  ticketTreeAdd(&tickets, 0, 50);
+  ticketTreeAdd(&tickets, 1, 150);
+  ticketTreeAdd(&tickets, MAX_SLOTS - 1, 1);
+  ticketTreeAdd(&tickets, 1, -150);
+  CU_ASSERT_EQUAL(ticketTreeTotal(&tickets), 51);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 49), 0);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 50), MAX_SLOTS - 1);
+  ticketTreeAdd(&tickets, 0, 200);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 249), 0);
+  CU_ASSERT_EQUAL(ticketTreeFind(&tickets, 250), MAX_SLOTS - 1);
+}
+
+int add_ticketTree_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, empty_tree_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, single_slot_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, find_matches_ranges_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, remove_and_change_test)) return 0;
+  return 1;
+}
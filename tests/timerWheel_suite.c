@@ -0,0 +1,91 @@
+#include "../src/Kernel/timerWheel.c"
+#include "CUnit/Basic.h"
+
+#define SLEEPERS 8
+
+static tProcess sleepers[SLEEPERS];
+static unsigned long delays[SLEEPERS] = {1,   2,    63,    64,
+                                         100, 4095, 4096, 300000};
+
+static void sleepAll(unsigned long now) {
+  timerWheelInit(now);
+  for (int i = 0; i < SLEEPERS; i++) {
+    linkInit(&sleepers[i].waitLink);
+    sleepers[i].wakeTick = now + delays[i];
+    listPushBack(timerWheelSlot(sleepers[i].wakeTick), &sleepers[i].waitLink);
+  }
+}
+
+// Advances the wheel until every sleeper woke up, checking each one wakes
+// exactly at its tick
+static int wakesOnTime(unsigned long now) {
+  int awake = 0, ok = 1;
+  while (awake < SLEEPERS && now < 400000) {
+    tList expired;
+    listInit(&expired);
+    timerWheelAdvance(&expired);
+    now++;
+    tLink* link;
+    while ((link = listPopFront(&expired)) != NULL) {
+      if (listEntry(link, tProcess, waitLink)->wakeTick != now) ok = 0;
+      awake++;
+    }
+  }
+  return ok && awake == SLEEPERS;
+}
+
+void wake_on_time_test() {
+  sleepAll(0);
+  CU_ASSERT_TRUE(wakesOnTime(0));
+}
+
+void wake_on_time_unaligned_test() {
+  sleepAll(4000);
+  CU_ASSERT_TRUE(wakesOnTime(4000));
+}
+
+void past_tick_test() {
+  timerWheelInit(10);
+  linkInit(&sleepers[0].waitLink);
+  sleepers[0].wakeTick = 5;
+  listPushBack(timerWheelSlot(5), &sleepers[0].waitLink);
+  tList expired;
+  listInit(&expired);
+  timerWheelAdvance(&expired);
+  CU_ASSERT_EQUAL(listSize(&expired), 1);
+}
+
+void removed_sleeper_test() {
+  sleepAll(0);
+  listRemove(&sleepers[3].waitLink);
+  int awake = 0;
+  for (int i = 0; i < 200; i++) {
+    tList expired;
+    listInit(&expired);
+    timerWheelAdvance(&expired);
+    awake += listSize(&expired);
+  }
+  CU_ASSERT_EQUAL(awake, 4);
+}
+
+void idle_ticks_test() {
+  timerWheelInit(0);
+  // nothing sleeping: up to the tick before the next cascade
+  CU_ASSERT_EQUAL(timerWheelIdleTicks(), 63);
+  linkInit(&sleepers[0].waitLink);
+  sleepers[0].wakeTick = 10;
+  listPushBack(timerWheelSlot(10), &sleepers[0].waitLink);
+  CU_ASSERT_EQUAL(timerWheelIdleTicks(), 10);
+
+  timerWheelInit(63);
+  CU_ASSERT_EQUAL(timerWheelIdleTicks(), 1);
+}
+
+int add_timerWheel_tests(CU_pSuite pSuite) {
+  if (NULL == CU_ADD_TEST(pSuite, wake_on_time_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, wake_on_time_unaligned_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, past_tick_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, removed_sleeper_test)) return 0;
+  if (NULL == CU_ADD_TEST(pSuite, idle_ticks_test)) return 0;
+  return 1;
+}